@@ -109,6 +109,13 @@ func (s *srpc) ServerHandler(service *protogen.Service) string {
 	return "SRPC" + service.GoName + "Handler"
 }
 
+func (s *srpc) CallStartPrefixVar(method *protogen.Method) string {
+	return "srpc" +
+		strings.ReplaceAll(method.Parent.GoName, "_", "__") + "_" +
+		strings.ReplaceAll(method.GoName, "_", "__") +
+		"CallStartPrefix"
+}
+
 func (s *srpc) ClientStreamIface(method *protogen.Method) string {
 	return "SRPC" +
 		strings.ReplaceAll(method.Parent.GoName, "_", "__") + "_" +
@@ -166,6 +173,18 @@ func (s *srpc) generateService(service *protogen.Service) {
 	// Client method implementations
 	s.P("func (c *", s.ClientImpl(service), ") SRPCClient() ", s.Ident(SRPCPackage, "Client"), "{ return c.cc }")
 	s.P()
+
+	// Pre-marshaled CallStart prefixes, computed once at init.
+	s.P("var (")
+	for _, method := range service.Methods {
+		serviceID, methodID := s.GetServiceAndMethodID(method)
+		s.P(
+			s.CallStartPrefixVar(method), " = ", s.Ident(SRPCPackage, "MarshalCallStartPrefix"),
+			"(", strconv.Quote(serviceID), ", ", strconv.Quote(methodID), ")",
+		)
+	}
+	s.P(")")
+	s.P()
 	for _, method := range service.Methods {
 		s.generateClientMethod(method)
 	}
@@ -227,6 +246,39 @@ func (s *srpc) generateService(service *protogen.Service) {
 	s.P("}")
 	s.P("}")
 
+	// InvokeUnaryMethod function (unary fast path).
+	var unaryMethods []*protogen.Method
+	for _, method := range service.Methods {
+		if !method.Desc.IsStreamingClient() && !method.Desc.IsStreamingServer() {
+			unaryMethods = append(unaryMethods, method)
+		}
+	}
+	if len(unaryMethods) != 0 {
+		s.P()
+		s.P("func (d *", s.ServerHandler(service), ") InvokeUnaryMethod(")
+		s.P("ctx ", s.Ident("context", "Context"), ",")
+		s.P("serviceID, methodID string,")
+		s.P("reqData []byte,")
+		s.P(") (", s.Ident(SRPCPackage, "Message"), ", bool, error) {")
+		s.P("if serviceID != \"\" && serviceID != d.GetServiceID() {")
+		s.P("return nil, false, nil")
+		s.P("}")
+		s.P()
+		s.P("switch methodID {")
+		for _, method := range unaryMethods {
+			_, methodID := s.GetServiceAndMethodID(method)
+			s.P("case ", strconv.Quote(methodID), ":")
+			s.P("req := new(", s.InputType(method), ")")
+			s.P("if err := req.UnmarshalVT(reqData); err != nil { return nil, true, err }")
+			s.P("out, err := d.impl.", method.GoName, "(ctx, req)")
+			s.P("return out, true, err")
+		}
+		s.P("default:")
+		s.P("return nil, false, nil")
+		s.P("}")
+		s.P("}")
+	}
+
 	// InvokeMethod_Echo function.
 	for _, method := range service.Methods {
 		inType := s.InputType(method)
@@ -254,7 +306,7 @@ func (s *srpc) generateService(service *protogen.Service) {
 				// non-streaming client, non-streaming server
 				s.P("out, err := impl.", method.GoName, "(strm.Context(), req)")
 				s.P("if err != nil { return err }")
-				s.P("return strm.MsgSend(out)")
+				s.P("return ", s.Ident(SRPCPackage, "MsgSendAndClose"), "(strm, out)")
 			}
 		}
 
@@ -319,7 +371,7 @@ func (s *srpc) generateClientMethod(p *protogen.Method) {
 	s.P("func (c *", recvType, ") ", s.generateClientSignature(p), "{")
 	if !p.Desc.IsStreamingServer() && !p.Desc.IsStreamingClient() {
 		s.P("out := new(", outType, ")")
-		s.P("err := c.cc.Invoke(ctx, ", serviceQuote, ", ", methodQuote, ", ", "in, out)")
+		s.P("err := ", s.Ident(SRPCPackage, "InvokeWithPrefix"), "(ctx, c.cc, ", s.CallStartPrefixVar(p), ", ", serviceQuote, ", ", methodQuote, ", ", "in, out)")
 		s.P("if err != nil { return nil, err }")
 		s.P("return out, nil")
 		s.P("}")
@@ -332,7 +384,7 @@ func (s *srpc) generateClientMethod(p *protogen.Method) {
 		firstMsgRef = "in"
 	}
 
-	s.P("stream, err := c.cc.NewStream(ctx, ", serviceQuote, ", ", methodQuote, ", ", firstMsgRef, ")")
+	s.P("stream, err := ", s.Ident(SRPCPackage, "NewStreamWithPrefix"), "(ctx, c.cc, ", s.CallStartPrefixVar(p), ", ", serviceQuote, ", ", methodQuote, ", ", firstMsgRef, ")")
 	s.P("if err != nil { return nil, err }")
 	s.P("strm := &", s.ClientStreamImpl(p), "{stream}")
 	if !p.Desc.IsStreamingClient() {
@@ -493,8 +545,7 @@ func (s *srpc) generateServerMethod(method *protogen.Method) {
 
 	if genSendAndClose {
 		s.P("func (x *", s.ServerStreamImpl(method), ") SendAndClose(m *", s.OutputType(method), ") error {")
-		s.P("if err := x.MsgSend(m); err != nil { return err }")
-		s.P("return x.CloseSend()")
+		s.P("return ", s.Ident(SRPCPackage, "MsgSendAndClose"), "(x.Stream, m)")
 		s.P("}")
 		s.P()
 	}
@@ -0,0 +1,203 @@
+package e2e
+
+import (
+	"context"
+	"net"
+	"strings"
+	"sync"
+	"testing"
+	"time"
+
+	"github.com/aperturerobotics/starpc/echo"
+	"github.com/aperturerobotics/starpc/rpcstream"
+	"github.com/aperturerobotics/starpc/srpc"
+	"github.com/libp2p/go-libp2p/p2p/muxer/mplex"
+	mp "github.com/libp2p/go-mplex"
+)
+
+// newBenchServer constructs the echo server for benchmarks.
+func newBenchServer(b *testing.B) *srpc.Server {
+	mux := srpc.NewMux()
+	echoServer := echo.NewEchoServer(mux)
+	if err := echo.SRPCRegisterEchoer(mux, echoServer); err != nil {
+		b.Fatal(err.Error())
+	}
+	return srpc.NewServer(mux)
+}
+
+// newBenchMplexClient constructs a client connected to the server over
+// mplex on an in-memory net.Pipe, mirroring the RunE2E harness.
+func newBenchMplexClient(b *testing.B, server *srpc.Server) srpc.Client {
+	clientPipe, serverPipe := net.Pipe()
+
+	// outbound=true
+	clientMp, err := mp.NewMultiplex(clientPipe, true, nil)
+	if err != nil {
+		b.Fatal(err.Error())
+	}
+	client := srpc.NewClientWithMuxedConn(mplex.NewMuxedConn(clientMp))
+
+	// outbound=false
+	serverMp, err := mp.NewMultiplex(serverPipe, false, nil)
+	if err != nil {
+		b.Fatal(err.Error())
+	}
+	go func() {
+		_ = server.AcceptMuxedConn(context.Background(), mplex.NewMuxedConn(serverMp))
+	}()
+
+	// wait a moment for the listener to start, as in RunE2E.
+	<-time.After(time.Millisecond * 100)
+	return client
+}
+
+// BenchmarkUnaryPipe measures unary Invoke latency over NewServerPipe.
+func BenchmarkUnaryPipe(b *testing.B) {
+	ctx := context.Background()
+	server := newBenchServer(b)
+	client := srpc.NewClient(srpc.NewServerPipe(server))
+	clientEcho := echo.NewSRPCEchoerClient(client)
+	req := &echo.EchoMsg{Body: "hello world"}
+
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		if _, err := clientEcho.Echo(ctx, req); err != nil {
+			b.Fatal(err.Error())
+		}
+	}
+}
+
+// BenchmarkStreamThroughput measures bidirectional streaming throughput
+// over mplex at several message sizes.
+func BenchmarkStreamThroughput(b *testing.B) {
+	for _, tc := range []struct {
+		label string
+		size  int
+	}{
+		{"1KB", 1 << 10},
+		{"64KB", 64 << 10},
+		{"1MB", 1 << 20},
+	} {
+		b.Run(tc.label, func(b *testing.B) {
+			ctx := context.Background()
+			server := newBenchServer(b)
+			client := newBenchMplexClient(b, server)
+			clientEcho := echo.NewSRPCEchoerClient(client)
+
+			strm, err := clientEcho.EchoBidiStream(ctx)
+			if err != nil {
+				b.Fatal(err.Error())
+			}
+			// consume the initial server message.
+			if _, err := strm.Recv(); err != nil {
+				b.Fatal(err.Error())
+			}
+			msg := &echo.EchoMsg{Body: strings.Repeat("a", tc.size)}
+
+			b.SetBytes(int64(tc.size))
+			b.ReportAllocs()
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				if err := strm.MsgSend(msg); err != nil {
+					b.Fatal(err.Error())
+				}
+				if _, err := strm.Recv(); err != nil {
+					b.Fatal(err.Error())
+				}
+			}
+			b.StopTimer()
+			_ = strm.Close()
+		})
+	}
+}
+
+// BenchmarkRpcStream measures unary calls proxied over a rpcstream.
+func BenchmarkRpcStream(b *testing.B) {
+	ctx := context.Background()
+	server := newBenchServer(b)
+	client := newBenchMplexClient(b, server)
+	clientEcho := echo.NewSRPCEchoerClient(client)
+
+	openStreamFn := rpcstream.NewRpcStreamOpenStream(func(ctx context.Context) (rpcstream.RpcStream, error) {
+		return clientEcho.RpcStream(ctx)
+	}, "test")
+	proxiedClient := srpc.NewClient(openStreamFn)
+	proxiedSvc := echo.NewSRPCEchoerClient(proxiedClient)
+	req := &echo.EchoMsg{Body: "hello world"}
+
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		if _, err := proxiedSvc.Echo(ctx, req); err != nil {
+			b.Fatal(err.Error())
+		}
+	}
+}
+
+// BenchmarkConcurrentStreams measures one echo round-trip on each of n
+// concurrently open bidirectional streams per iteration.
+func BenchmarkConcurrentStreams(b *testing.B) {
+	for _, tc := range []struct {
+		label string
+		count int
+	}{
+		{"1", 1},
+		{"100", 100},
+		{"10000", 10000},
+	} {
+		b.Run(tc.label, func(b *testing.B) {
+			ctx := context.Background()
+			server := newBenchServer(b)
+			client := newBenchMplexClient(b, server)
+			clientEcho := echo.NewSRPCEchoerClient(client)
+
+			// open the streams & consume the initial server messages.
+			strms := make([]echo.SRPCEchoer_EchoBidiStreamClient, tc.count)
+			for i := range strms {
+				strm, err := clientEcho.EchoBidiStream(ctx)
+				if err != nil {
+					b.Fatal(err.Error())
+				}
+				if _, err := strm.Recv(); err != nil {
+					b.Fatal(err.Error())
+				}
+				strms[i] = strm
+			}
+			msg := &echo.EchoMsg{Body: "hello world"}
+
+			b.ReportAllocs()
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				var wg sync.WaitGroup
+				errCh := make(chan error, 1)
+				for _, strm := range strms {
+					wg.Add(1)
+					go func(strm echo.SRPCEchoer_EchoBidiStreamClient) {
+						defer wg.Done()
+						err := strm.MsgSend(msg)
+						if err == nil {
+							_, err = strm.Recv()
+						}
+						if err != nil {
+							select {
+							case errCh <- err:
+							default:
+							}
+						}
+					}(strm)
+				}
+				wg.Wait()
+				select {
+				case err := <-errCh:
+					b.Fatal(err.Error())
+				default:
+				}
+			}
+			b.StopTimer()
+			for _, strm := range strms {
+				_ = strm.Close()
+			}
+		})
+	}
+}
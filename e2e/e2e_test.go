@@ -4,6 +4,8 @@ import (
 	"context"
 	"io"
 	"net"
+	"strings"
+	"sync"
 	"testing"
 	"time"
 
@@ -59,6 +61,674 @@ func RunE2E(t *testing.T, cb func(client echo.SRPCEchoerClient) error) {
 	}
 }
 
+func TestE2E_PacketStream(t *testing.T) {
+	ctx := context.Background()
+
+	// construct the server
+	mux := srpc.NewMux()
+	echoServer := echo.NewEchoServer(mux)
+	if err := echo.SRPCRegisterEchoer(mux, echoServer); err != nil {
+		t.Fatal(err.Error())
+	}
+	server := srpc.NewServer(mux)
+
+	// multiplex rpcs over a single packet stream, no stream muxer.
+	clientPipe, serverPipe := net.Pipe()
+	go func() {
+		_ = server.HandlePacketStream(ctx, serverPipe)
+	}()
+	client := srpc.NewClientWithPacketStream(ctx, clientPipe)
+	clientEcho := echo.NewSRPCEchoerClient(client)
+
+	// run a unary and a bidirectional call over the shared stream.
+	bodyTxt := "hello world"
+	out, err := clientEcho.Echo(ctx, &echo.EchoMsg{Body: bodyTxt})
+	if err != nil {
+		t.Fatal(err.Error())
+	}
+	if out.GetBody() != bodyTxt {
+		t.Fatalf("expected %q got %q", bodyTxt, out.GetBody())
+	}
+	strmOut, err := clientEcho.EchoServerStream(ctx, &echo.EchoMsg{Body: bodyTxt})
+	if err != nil {
+		t.Fatal(err.Error())
+	}
+	if err := CheckServerStream(t, strmOut, &echo.EchoMsg{Body: bodyTxt}); err != nil {
+		t.Fatal(err.Error())
+	}
+}
+
+func TestE2E_PacketListener(t *testing.T) {
+	ctx, ctxCancel := context.WithCancel(context.Background())
+	defer ctxCancel()
+
+	// construct the server
+	mux := srpc.NewMux()
+	echoServer := echo.NewEchoServer(mux)
+	if err := echo.SRPCRegisterEchoer(mux, echoServer); err != nil {
+		t.Fatal(err.Error())
+	}
+	server := srpc.NewServer(mux)
+
+	// serve each accepted conn with a single shared read loop.
+	lis, err := net.Listen("tcp", "127.0.0.1:0")
+	if err != nil {
+		t.Fatal(err.Error())
+	}
+	defer lis.Close()
+	go func() {
+		_ = srpc.AcceptPacketListener(ctx, lis, server)
+	}()
+
+	conn, err := net.Dial("tcp", lis.Addr().String())
+	if err != nil {
+		t.Fatal(err.Error())
+	}
+	client := srpc.NewClientWithPacketStream(ctx, conn)
+	clientEcho := echo.NewSRPCEchoerClient(client)
+
+	bodyTxt := "hello world"
+	out, err := clientEcho.Echo(ctx, &echo.EchoMsg{Body: bodyTxt})
+	if err != nil {
+		t.Fatal(err.Error())
+	}
+	if out.GetBody() != bodyTxt {
+		t.Fatalf("expected %q got %q", bodyTxt, out.GetBody())
+	}
+}
+
+func TestE2E_PooledRPCState(t *testing.T) {
+	ctx := context.Background()
+
+	// construct the server
+	mux := srpc.NewMux()
+	echoServer := echo.NewEchoServer(mux)
+	if err := echo.SRPCRegisterEchoer(mux, echoServer); err != nil {
+		t.Fatal(err.Error())
+	}
+	server := srpc.NewServer(mux)
+	client := srpc.NewClient(srpc.NewServerPipe(server))
+	clientEcho := echo.NewSRPCEchoerClient(client)
+
+	// sequential calls exercise recycling the pooled rpc state blocks.
+	bodyTxt := "hello world"
+	for i := 0; i < 50; i++ {
+		out, err := clientEcho.Echo(ctx, &echo.EchoMsg{Body: bodyTxt})
+		if err != nil {
+			t.Fatal(err.Error())
+		}
+		if out.GetBody() != bodyTxt {
+			t.Fatalf("expected %q got %q", bodyTxt, out.GetBody())
+		}
+	}
+}
+
+func TestE2E_KeepAlive(t *testing.T) {
+	// a silent peer misses the keep-alive deadline and is reaped.
+	clientPipe, serverPipe := net.Pipe()
+	defer serverPipe.Close()
+	prw := srpc.NewPacketReadWriter(clientPipe)
+	prw.SetKeepAlive(time.Millisecond*50, time.Millisecond*150)
+	errCh := make(chan error, 1)
+	go prw.ReadPump(func(pkt *srpc.Packet) error { return nil }, func(err error) {
+		errCh <- err
+	})
+	// drain the probes without ever responding.
+	go func() {
+		buf := make([]byte, 1024)
+		for {
+			if _, err := serverPipe.Read(buf); err != nil {
+				return
+			}
+		}
+	}()
+	select {
+	case err := <-errCh:
+		if err != srpc.ErrKeepAliveTimeout {
+			t.Fatalf("expected keep-alive timeout, got %v", err)
+		}
+	case <-time.After(time.Second * 3):
+		t.Fatal("expected the keep-alive pump to reap the connection")
+	}
+}
+
+func TestE2E_KeepAlivePacketStream(t *testing.T) {
+	// keep-alive enabled on both ends of a packet stream: probes and
+	// rpc traffic share the connection and idle gaps do not reap it.
+	mux := srpc.NewMux()
+	echoServer := echo.NewEchoServer(mux)
+	if err := echo.SRPCRegisterEchoer(mux, echoServer); err != nil {
+		t.Fatal(err.Error())
+	}
+	server := srpc.NewServer(mux)
+	server.SetKeepAlive(time.Millisecond*50, time.Millisecond*300)
+
+	ctx := context.Background()
+	clientPipe, serverPipe := net.Pipe()
+	go func() {
+		_ = server.HandlePacketStream(ctx, serverPipe)
+	}()
+	client := srpc.NewClientWithPacketStreamKeepAlive(ctx, clientPipe, time.Millisecond*50, time.Millisecond*300)
+	clientEcho := echo.NewSRPCEchoerClient(client)
+
+	for i := 0; i < 3; i++ {
+		out, err := clientEcho.Echo(ctx, &echo.EchoMsg{Body: "hello world"})
+		if err != nil {
+			t.Fatal(err.Error())
+		}
+		if out.GetBody() != "hello world" {
+			t.Fatalf("expected %q got %q", "hello world", out.GetBody())
+		}
+		<-time.After(time.Millisecond * 120)
+	}
+}
+
+func TestE2E_ZeroCopyRecv(t *testing.T) {
+	RunE2E(t, func(client echo.SRPCEchoerClient) error {
+		ctx := context.Background()
+		strm, err := client.EchoBidiStream(ctx)
+		if err != nil {
+			return err
+		}
+		// the generated wrapper embeds the srpc.Stream: the zero-copy
+		// toggle reaches the underlying MsgStream. EchoMsg has no
+		// UnmarshalVTUnsafe, exercising the copying fallback.
+		if !srpc.EnableStreamZeroCopy(strm) {
+			return errors.New("expected stream to support zero-copy receive")
+		}
+		if _, err := strm.Recv(); err != nil {
+			return err
+		}
+		bodyTxt := "hello world"
+		if err := strm.Send(&echo.EchoMsg{Body: bodyTxt}); err != nil {
+			return err
+		}
+		out, err := strm.Recv()
+		if err != nil {
+			return err
+		}
+		if out.GetBody() != bodyTxt {
+			return errors.Errorf("expected %v got %v", bodyTxt, out.GetBody())
+		}
+		return strm.Close()
+	})
+}
+
+func TestE2E_StreamPool(t *testing.T) {
+	ctx, ctxCancel := context.WithCancel(context.Background())
+	defer ctxCancel()
+
+	// construct the server
+	mux := srpc.NewMux()
+	echoServer := echo.NewEchoServer(mux)
+	if err := echo.SRPCRegisterEchoer(mux, echoServer); err != nil {
+		t.Fatal(err.Error())
+	}
+	server := srpc.NewServer(mux)
+
+	// keep 2 streams pre-opened ahead of demand.
+	pool := srpc.NewStreamPool(ctx, srpc.NewServerPipe(server), 2)
+	defer pool.Close()
+	client := srpc.NewClient(pool.OpenStream)
+	clientEcho := echo.NewSRPCEchoerClient(client)
+
+	// give the pool a moment to pre-open streams.
+	<-time.After(time.Millisecond * 100)
+
+	// run several calls: warm and fallback paths both round-trip.
+	bodyTxt := "hello world"
+	for i := 0; i < 4; i++ {
+		out, err := clientEcho.Echo(ctx, &echo.EchoMsg{Body: bodyTxt})
+		if err != nil {
+			t.Fatal(err.Error())
+		}
+		if out.GetBody() != bodyTxt {
+			t.Fatalf("expected %q got %q", bodyTxt, out.GetBody())
+		}
+	}
+}
+
+func TestE2E_YamuxNegotiate(t *testing.T) {
+	ctx, ctxCancel := context.WithCancel(context.Background())
+	defer ctxCancel()
+
+	// construct the server
+	mux := srpc.NewMux()
+	echoServer := echo.NewEchoServer(mux)
+	if err := echo.SRPCRegisterEchoer(mux, echoServer); err != nil {
+		t.Fatal(err.Error())
+	}
+	server := srpc.NewServer(mux)
+
+	// negotiate the yamux muxer per connection.
+	srpc.SetYamuxWindowSize(1 << 20)
+	defer srpc.SetYamuxWindowSize(0)
+	lis, err := net.Listen("tcp", "127.0.0.1:0")
+	if err != nil {
+		t.Fatal(err.Error())
+	}
+	defer lis.Close()
+	go func() {
+		_ = srpc.AcceptMuxedListenerNegotiate(ctx, lis, server)
+	}()
+
+	conn, err := net.Dial("tcp", lis.Addr().String())
+	if err != nil {
+		t.Fatal(err.Error())
+	}
+	client, err := srpc.NewClientWithNegotiatedMuxer(conn, srpc.MuxerTypeYamux)
+	if err != nil {
+		t.Fatal(err.Error())
+	}
+	clientEcho := echo.NewSRPCEchoerClient(client)
+
+	bodyTxt := "hello world"
+	out, err := clientEcho.Echo(ctx, &echo.EchoMsg{Body: bodyTxt})
+	if err != nil {
+		t.Fatal(err.Error())
+	}
+	if out.GetBody() != bodyTxt {
+		t.Fatalf("expected %q got %q", bodyTxt, out.GetBody())
+	}
+}
+
+func TestE2E_ChunkedData(t *testing.T) {
+	// split outgoing messages into small fragments to exercise reassembly.
+	srpc.SetDataChunkSize(16)
+	defer srpc.SetDataChunkSize(0)
+
+	RunE2E(t, func(client echo.SRPCEchoerClient) error {
+		ctx := context.Background()
+		bodyTxt := strings.Repeat("chunked hello world ", 50)
+		out, err := client.Echo(ctx, &echo.EchoMsg{
+			Body: bodyTxt,
+		})
+		if err != nil {
+			return err
+		}
+		if out.GetBody() != bodyTxt {
+			return errors.Errorf("expected %v got %v", bodyTxt, out.GetBody())
+		}
+		return nil
+	})
+}
+
+func TestE2E_InvokeChunkedResponse(t *testing.T) {
+	// split outgoing messages into small fragments to exercise
+	// reassembly on the unary invoke fast path.
+	srpc.SetDataChunkSize(16)
+	defer srpc.SetDataChunkSize(0)
+
+	// construct the server, hiding the unary fast path so the
+	// response streams back in chunked fragments.
+	mux := srpc.NewMux()
+	echoServer := echo.NewEchoServer(mux)
+	if err := echo.SRPCRegisterEchoer(mux, echoServer); err != nil {
+		t.Fatal(err.Error())
+	}
+	server := srpc.NewServer(struct{ srpc.Mux }{mux})
+
+	ctx := context.Background()
+	clientPipe, serverPipe := net.Pipe()
+	go func() {
+		_ = server.HandlePacketStream(ctx, serverPipe)
+	}()
+	client := srpc.NewClientWithPacketStream(ctx, clientPipe)
+	clientEcho := echo.NewSRPCEchoerClient(client)
+
+	bodyTxt := strings.Repeat("chunked hello world ", 50)
+	out, err := clientEcho.Echo(ctx, &echo.EchoMsg{Body: bodyTxt})
+	if err != nil {
+		t.Fatal(err.Error())
+	}
+	if out.GetBody() != bodyTxt {
+		t.Fatalf("expected %q got %q", bodyTxt, out.GetBody())
+	}
+}
+
+func TestE2E_Compression(t *testing.T) {
+	RunE2E(t, func(client echo.SRPCEchoerClient) error {
+		// offer deflate compression for the rpc message data.
+		ctx := srpc.WithCompression(context.Background(), srpc.CompressDeflate)
+		bodyTxt := strings.Repeat("compressed hello world ", 50)
+		out, err := client.Echo(ctx, &echo.EchoMsg{
+			Body: bodyTxt,
+		})
+		if err != nil {
+			return err
+		}
+		if out.GetBody() != bodyTxt {
+			return errors.Errorf("expected %v got %v", bodyTxt, out.GetBody())
+		}
+		return nil
+	})
+}
+
+func TestE2E_Deadline(t *testing.T) {
+	RunE2E(t, func(client echo.SRPCEchoerClient) error {
+		// the deadline propagates to the server via CallStart.
+		// the server marks the echoed body when its stream context
+		// carries a deadline and streams 5 messages with 200ms between
+		// each: expect the marker & the deadline to cut the stream short.
+		ctx, ctxCancel := context.WithTimeout(context.Background(), time.Millisecond*300)
+		defer ctxCancel()
+		strm, err := client.EchoServerStream(ctx, &echo.EchoMsg{Body: "hello world"})
+		if err != nil {
+			return err
+		}
+		var recvd int
+		for {
+			msg, err := strm.Recv()
+			if err != nil {
+				if recvd == 0 {
+					return errors.New("expected a message before the deadline")
+				}
+				if recvd >= 5 {
+					return errors.New("expected deadline to interrupt the stream")
+				}
+				return nil
+			}
+			if !strings.HasSuffix(msg.GetBody(), "[deadline]") {
+				return errors.Errorf("expected deadline marker on the echoed body, got %q", msg.GetBody())
+			}
+			recvd++
+		}
+	})
+}
+
+func TestE2E_MixedSizeMessages(t *testing.T) {
+	ctx := context.Background()
+	RunE2E(t, func(client echo.SRPCEchoerClient) error {
+		strm, err := client.EchoBidiStream(ctx)
+		if err != nil {
+			return err
+		}
+		// consume the server greeting
+		if _, err := strm.Recv(); err != nil {
+			return err
+		}
+		// exercise frame sizes across the read buffer tiers.
+		for i, size := range []int{1, 600, 3000, 40000, 200000} {
+			body := strings.Repeat(string(rune('a'+i)), size)
+			if err := strm.Send(&echo.EchoMsg{Body: body}); err != nil {
+				return err
+			}
+			msg, err := strm.Recv()
+			if err != nil {
+				return err
+			}
+			if msg.GetBody() != body {
+				return errors.Errorf("echo of %d byte message corrupted", size)
+			}
+		}
+		return strm.Close()
+	})
+}
+
+func TestE2E_MaxResponseSize(t *testing.T) {
+	RunE2E(t, func(client echo.SRPCEchoerClient) error {
+		// the response exceeds the 4 byte limit: expect an error.
+		ctx := srpc.WithMaxResponseSize(context.Background(), 4)
+		_, err := client.Echo(ctx, &echo.EchoMsg{Body: "hello world"})
+		if err == nil || !strings.Contains(err.Error(), srpc.ErrResponseTooLarge.Error()) {
+			return errors.Errorf("expected response size limit error, got: %v", err)
+		}
+
+		// within the limit the call succeeds.
+		ctx = srpc.WithMaxResponseSize(context.Background(), 1024)
+		out, err := client.Echo(ctx, &echo.EchoMsg{Body: "hello world"})
+		if err != nil {
+			return err
+		}
+		if out.GetBody() != "hello world" {
+			return errors.Errorf("response body incorrect: %q", out.GetBody())
+		}
+		return nil
+	})
+}
+
+func TestE2E_ServerLimits(t *testing.T) {
+	// construct a server limited to a single in-flight rpc.
+	mux := srpc.NewMux()
+	echoServer := echo.NewEchoServer(mux)
+	if err := echo.SRPCRegisterEchoer(mux, echoServer); err != nil {
+		t.Fatal(err.Error())
+	}
+	server := srpc.NewServerWithLimits(mux, 1, 1)
+
+	clientPipe, serverPipe := net.Pipe()
+	clientMp, err := mp.NewMultiplex(clientPipe, true, nil)
+	if err != nil {
+		t.Fatal(err.Error())
+	}
+	client := srpc.NewClientWithMuxedConn(mplex.NewMuxedConn(clientMp))
+
+	ctx := context.Background()
+	serverMp, _ := mp.NewMultiplex(serverPipe, false, nil)
+	go func() {
+		_ = server.AcceptMuxedConn(ctx, mplex.NewMuxedConn(serverMp))
+	}()
+	<-time.After(time.Millisecond * 100)
+
+	clientEcho := echo.NewSRPCEchoerClient(client)
+
+	// occupy the only rpc slot with a bidirectional stream.
+	strm, err := clientEcho.EchoBidiStream(ctx)
+	if err != nil {
+		t.Fatal(err.Error())
+	}
+	if _, err := strm.Recv(); err != nil {
+		t.Fatal(err.Error())
+	}
+
+	// the next rpc should be rejected with the overload error.
+	if _, err := clientEcho.Echo(ctx, &echo.EchoMsg{Body: "hello"}); err == nil {
+		t.Fatal("expected overloaded error but rpc succeeded")
+	} else if !strings.Contains(err.Error(), "server overloaded") {
+		t.Fatalf("expected server overloaded error, got: %v", err.Error())
+	}
+
+	// release the slot: the next rpc should be admitted.
+	if err := strm.Close(); err != nil {
+		t.Fatal(err.Error())
+	}
+	<-time.After(time.Millisecond * 100)
+	if _, err := clientEcho.Echo(ctx, &echo.EchoMsg{Body: "hello"}); err != nil {
+		t.Fatal(err.Error())
+	}
+}
+
+func TestE2E_FrozenMux(t *testing.T) {
+	ctx := context.Background()
+
+	// construct the server with an immutable dispatch table.
+	mux := srpc.NewMux()
+	echoServer := echo.NewEchoServer(mux)
+	if err := echo.SRPCRegisterEchoer(mux, echoServer); err != nil {
+		t.Fatal(err.Error())
+	}
+	server := srpc.NewServer(srpc.FreezeMux(mux))
+
+	client := srpc.NewClient(srpc.NewServerPipe(server))
+	clientEcho := echo.NewSRPCEchoerClient(client)
+
+	bodyTxt := "hello world"
+	out, err := clientEcho.Echo(ctx, &echo.EchoMsg{Body: bodyTxt})
+	if err != nil {
+		t.Fatal(err.Error())
+	}
+	if out.GetBody() != bodyTxt {
+		t.Fatalf("expected %q got %q", bodyTxt, out.GetBody())
+	}
+}
+
+// pipeRpcStream adapts a srpc.Stream to the rpcstream.RpcStream interface.
+type pipeRpcStream struct {
+	srpc.Stream
+}
+
+func (s pipeRpcStream) Send(p *rpcstream.RpcStreamPacket) error {
+	return s.MsgSend(p)
+}
+
+func (s pipeRpcStream) Recv() (*rpcstream.RpcStreamPacket, error) {
+	m := &rpcstream.RpcStreamPacket{}
+	if err := s.MsgRecv(m); err != nil {
+		return nil, err
+	}
+	return m, nil
+}
+
+func TestE2E_RpcStreamDirect(t *testing.T) {
+	ctx := context.Background()
+
+	// construct the server
+	mux := srpc.NewMux()
+	echoServer := echo.NewEchoServer(mux)
+	if err := echo.SRPCRegisterEchoer(mux, echoServer); err != nil {
+		t.Fatal(err.Error())
+	}
+
+	// carry the rpc stream over an in-memory stream pair.
+	s1, s2 := srpc.NewPipeStream(ctx)
+	go func() {
+		_ = rpcstream.HandleRpcStreamDirect(pipeRpcStream{s2}, func(ctx context.Context, componentID string) (srpc.Mux, error) {
+			return mux, nil
+		})
+	}()
+
+	openStreamFn := rpcstream.NewRpcStreamOpenStreamDirect(func(ctx context.Context) (rpcstream.RpcStream, error) {
+		return pipeRpcStream{s1}, nil
+	}, "test")
+	client := srpc.NewClient(openStreamFn)
+	clientEcho := echo.NewSRPCEchoerClient(client)
+
+	bodyTxt := "hello world"
+	out, err := clientEcho.Echo(ctx, &echo.EchoMsg{Body: bodyTxt})
+	if err != nil {
+		t.Fatal(err.Error())
+	}
+	if out.GetBody() != bodyTxt {
+		t.Fatalf("expected %q got %q", bodyTxt, out.GetBody())
+	}
+}
+
+func TestE2E_DirectClient(t *testing.T) {
+	ctx := context.Background()
+
+	// construct the server
+	mux := srpc.NewMux()
+	echoServer := echo.NewEchoServer(mux)
+	if err := echo.SRPCRegisterEchoer(mux, echoServer); err != nil {
+		t.Fatal(err.Error())
+	}
+	server := srpc.NewServer(mux)
+
+	// dispatch calls in-process without serialization.
+	client := srpc.NewDirectClient(server)
+	clientEcho := echo.NewSRPCEchoerClient(client)
+
+	bodyTxt := "hello world"
+	out, err := clientEcho.Echo(ctx, &echo.EchoMsg{Body: bodyTxt})
+	if err != nil {
+		t.Fatal(err.Error())
+	}
+	if out.GetBody() != bodyTxt {
+		t.Fatalf("expected %q got %q", bodyTxt, out.GetBody())
+	}
+	strmOut, err := clientEcho.EchoServerStream(ctx, &echo.EchoMsg{Body: bodyTxt})
+	if err != nil {
+		t.Fatal(err.Error())
+	}
+	if err := CheckServerStream(t, strmOut, &echo.EchoMsg{Body: bodyTxt}); err != nil {
+		t.Fatal(err.Error())
+	}
+}
+
+func TestE2E_DirectStreamClose(t *testing.T) {
+	ctx := context.Background()
+	s1, s2 := srpc.NewDirectStream(ctx)
+	if err := s1.Close(); err != nil {
+		t.Fatal(err.Error())
+	}
+	// sending on a closed stream errors instead of panicking.
+	if err := s1.MsgSend(&echo.EchoMsg{Body: "hello"}); err == nil {
+		t.Fatal("expected error sending on closed stream")
+	}
+	// the peer context cancels when the other end closes.
+	<-s2.Context().Done()
+}
+
+// testStatsHandler counts rpc lifecycle events.
+type testStatsHandler struct {
+	mtx                          sync.Mutex
+	opens, firstBytes, completes int
+	sentMsgs, recvMsgs           uint64
+}
+
+func (h *testStatsHandler) HandleStreamOpen(service, method string, isClient bool) {
+	h.mtx.Lock()
+	h.opens++
+	h.mtx.Unlock()
+}
+
+func (h *testStatsHandler) HandleFirstByte(service, method string, isClient bool, elapsed time.Duration) {
+	h.mtx.Lock()
+	h.firstBytes++
+	h.mtx.Unlock()
+}
+
+func (h *testStatsHandler) HandleComplete(
+	service, method string,
+	isClient bool,
+	sentMsgs, sentBytes, recvMsgs, recvBytes uint64,
+	elapsed time.Duration,
+	rpcErr error,
+) {
+	h.mtx.Lock()
+	h.completes++
+	h.sentMsgs += sentMsgs
+	h.recvMsgs += recvMsgs
+	h.mtx.Unlock()
+}
+
+func TestE2E_StatsHandler(t *testing.T) {
+	handler := &testStatsHandler{}
+	srpc.SetStatsHandler(handler)
+	defer srpc.SetStatsHandler(nil)
+
+	RunE2E(t, func(client echo.SRPCEchoerClient) error {
+		ctx := context.Background()
+		bodyTxt := "hello world"
+		out, err := client.Echo(ctx, &echo.EchoMsg{
+			Body: bodyTxt,
+		})
+		if err != nil {
+			return err
+		}
+		if out.GetBody() != bodyTxt {
+			return errors.Errorf("expected %v got %v", bodyTxt, out.GetBody())
+		}
+		return nil
+	})
+
+	handler.mtx.Lock()
+	defer handler.mtx.Unlock()
+	// expect events from both the client and server side of the call.
+	if handler.opens < 2 {
+		t.Fatalf("expected at least 2 stream opens, got %v", handler.opens)
+	}
+	if handler.completes < 2 {
+		t.Fatalf("expected at least 2 completions, got %v", handler.completes)
+	}
+	if handler.firstBytes == 0 || handler.sentMsgs == 0 || handler.recvMsgs == 0 {
+		t.Fatalf(
+			"expected nonzero first byte / message counts, got %v / %v / %v",
+			handler.firstBytes, handler.sentMsgs, handler.recvMsgs,
+		)
+	}
+}
+
 func TestE2E_Unary(t *testing.T) {
 	ctx := context.Background()
 	RunE2E(t, func(client echo.SRPCEchoerClient) error {
@@ -204,3 +874,57 @@ func TestE2E_RpcStream(t *testing.T) {
 		return nil
 	})
 }
+
+func TestE2E_RpcStreamPipelined(t *testing.T) {
+	ctx := context.Background()
+	RunE2E(t, func(client echo.SRPCEchoerClient) error {
+		openStreamFn := rpcstream.NewRpcStreamOpenStreamPipelined(func(ctx context.Context) (rpcstream.RpcStream, error) {
+			return client.RpcStream(ctx)
+		}, "test")
+		proxiedClient := srpc.NewClient(openStreamFn)
+		proxiedSvc := echo.NewSRPCEchoerClient(proxiedClient)
+
+		// the first call performs the full init/ack handshake, the
+		// second pipelines the init without waiting for the ack.
+		for i := 0; i < 2; i++ {
+			resp, err := proxiedSvc.Echo(ctx, &echo.EchoMsg{Body: "hello world"})
+			if err != nil {
+				return err
+			}
+			if resp.GetBody() != "hello world" {
+				return errors.Errorf("response body incorrect: %q", resp.GetBody())
+			}
+		}
+
+		return nil
+	})
+}
+
+func TestE2E_CachedRpcStreamGetter(t *testing.T) {
+	ctx := context.Background()
+	mux := srpc.NewMux()
+	var calls int
+	cached := rpcstream.NewCachedRpcStreamGetter(func(ctx context.Context, componentID string) (srpc.Mux, error) {
+		calls++
+		return mux, nil
+	})
+	for i := 0; i < 3; i++ {
+		rmux, err := cached.GetMux(ctx, "test")
+		if err != nil {
+			t.Fatal(err.Error())
+		}
+		if rmux != mux {
+			t.Fatal("expected the cached mux")
+		}
+	}
+	if calls != 1 {
+		t.Fatalf("expected 1 getter call, got %d", calls)
+	}
+	cached.Invalidate("test")
+	if _, err := cached.GetMux(ctx, "test"); err != nil {
+		t.Fatal(err.Error())
+	}
+	if calls != 2 {
+		t.Fatalf("expected 2 getter calls after invalidate, got %d", calls)
+	}
+}
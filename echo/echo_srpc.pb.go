@@ -31,9 +31,17 @@ func NewSRPCEchoerClient(cc srpc.Client) SRPCEchoerClient {
 
 func (c *srpcEchoerClient) SRPCClient() srpc.Client { return c.cc }
 
+var (
+	srpcEchoer_EchoCallStartPrefix             = srpc.MarshalCallStartPrefix("echo.Echoer", "Echo")
+	srpcEchoer_EchoServerStreamCallStartPrefix = srpc.MarshalCallStartPrefix("echo.Echoer", "EchoServerStream")
+	srpcEchoer_EchoClientStreamCallStartPrefix = srpc.MarshalCallStartPrefix("echo.Echoer", "EchoClientStream")
+	srpcEchoer_EchoBidiStreamCallStartPrefix   = srpc.MarshalCallStartPrefix("echo.Echoer", "EchoBidiStream")
+	srpcEchoer_RpcStreamCallStartPrefix        = srpc.MarshalCallStartPrefix("echo.Echoer", "RpcStream")
+)
+
 func (c *srpcEchoerClient) Echo(ctx context.Context, in *EchoMsg) (*EchoMsg, error) {
 	out := new(EchoMsg)
-	err := c.cc.Invoke(ctx, "echo.Echoer", "Echo", in, out)
+	err := srpc.InvokeWithPrefix(ctx, c.cc, srpcEchoer_EchoCallStartPrefix, "echo.Echoer", "Echo", in, out)
 	if err != nil {
 		return nil, err
 	}
@@ -41,7 +49,7 @@ func (c *srpcEchoerClient) Echo(ctx context.Context, in *EchoMsg) (*EchoMsg, err
 }
 
 func (c *srpcEchoerClient) EchoServerStream(ctx context.Context, in *EchoMsg) (SRPCEchoer_EchoServerStreamClient, error) {
-	stream, err := c.cc.NewStream(ctx, "echo.Echoer", "EchoServerStream", in)
+	stream, err := srpc.NewStreamWithPrefix(ctx, c.cc, srpcEchoer_EchoServerStreamCallStartPrefix, "echo.Echoer", "EchoServerStream", in)
 	if err != nil {
 		return nil, err
 	}
@@ -75,7 +83,7 @@ func (x *srpcEchoer_EchoServerStreamClient) RecvTo(m *EchoMsg) error {
 }
 
 func (c *srpcEchoerClient) EchoClientStream(ctx context.Context) (SRPCEchoer_EchoClientStreamClient, error) {
-	stream, err := c.cc.NewStream(ctx, "echo.Echoer", "EchoClientStream", nil)
+	stream, err := srpc.NewStreamWithPrefix(ctx, c.cc, srpcEchoer_EchoClientStreamCallStartPrefix, "echo.Echoer", "EchoClientStream", nil)
 	if err != nil {
 		return nil, err
 	}
@@ -116,7 +124,7 @@ func (x *srpcEchoer_EchoClientStreamClient) CloseAndMsgRecv(m *EchoMsg) error {
 }
 
 func (c *srpcEchoerClient) EchoBidiStream(ctx context.Context) (SRPCEchoer_EchoBidiStreamClient, error) {
-	stream, err := c.cc.NewStream(ctx, "echo.Echoer", "EchoBidiStream", nil)
+	stream, err := srpc.NewStreamWithPrefix(ctx, c.cc, srpcEchoer_EchoBidiStreamCallStartPrefix, "echo.Echoer", "EchoBidiStream", nil)
 	if err != nil {
 		return nil, err
 	}
@@ -152,7 +160,7 @@ func (x *srpcEchoer_EchoBidiStreamClient) RecvTo(m *EchoMsg) error {
 }
 
 func (c *srpcEchoerClient) RpcStream(ctx context.Context) (SRPCEchoer_RpcStreamClient, error) {
-	stream, err := c.cc.NewStream(ctx, "echo.Echoer", "RpcStream", nil)
+	stream, err := srpc.NewStreamWithPrefix(ctx, c.cc, srpcEchoer_RpcStreamCallStartPrefix, "echo.Echoer", "RpcStream", nil)
 	if err != nil {
 		return nil, err
 	}
@@ -259,6 +267,28 @@ func (d *SRPCEchoerHandler) InvokeMethod(
 	}
 }
 
+func (d *SRPCEchoerHandler) InvokeUnaryMethod(
+	ctx context.Context,
+	serviceID, methodID string,
+	reqData []byte,
+) (srpc.Message, bool, error) {
+	if serviceID != "" && serviceID != d.GetServiceID() {
+		return nil, false, nil
+	}
+
+	switch methodID {
+	case "Echo":
+		req := new(EchoMsg)
+		if err := req.UnmarshalVT(reqData); err != nil {
+			return nil, true, err
+		}
+		out, err := d.impl.Echo(ctx, req)
+		return out, true, err
+	default:
+		return nil, false, nil
+	}
+}
+
 func (SRPCEchoerHandler) InvokeMethod_Echo(impl SRPCEchoerServer, strm srpc.Stream) error {
 	req := new(EchoMsg)
 	if err := strm.MsgRecv(req); err != nil {
@@ -268,7 +298,7 @@ func (SRPCEchoerHandler) InvokeMethod_Echo(impl SRPCEchoerServer, strm srpc.Stre
 	if err != nil {
 		return err
 	}
-	return strm.MsgSend(out)
+	return srpc.MsgSendAndClose(strm, out)
 }
 
 func (SRPCEchoerHandler) InvokeMethod_EchoServerStream(impl SRPCEchoerServer, strm srpc.Stream) error {
@@ -309,10 +339,7 @@ type srpcEchoer_EchoStream struct {
 }
 
 func (x *srpcEchoer_EchoStream) SendAndClose(m *EchoMsg) error {
-	if err := x.MsgSend(m); err != nil {
-		return err
-	}
-	return x.CloseSend()
+	return srpc.MsgSendAndClose(x.Stream, m)
 }
 
 type SRPCEchoer_EchoServerStreamStream interface {
@@ -339,10 +366,7 @@ type srpcEchoer_EchoClientStreamStream struct {
 }
 
 func (x *srpcEchoer_EchoClientStreamStream) SendAndClose(m *EchoMsg) error {
-	if err := x.MsgSend(m); err != nil {
-		return err
-	}
-	return x.CloseSend()
+	return srpc.MsgSendAndClose(x.Stream, m)
 }
 
 func (x *srpcEchoer_EchoClientStreamStream) Recv() (*EchoMsg, error) {
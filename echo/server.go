@@ -33,6 +33,11 @@ func (*EchoServer) Echo(ctx context.Context, msg *EchoMsg) (*EchoMsg, error) {
 
 // EchoServerStream implements SRPCEchoerServer
 func (*EchoServer) EchoServerStream(msg *EchoMsg, strm SRPCEchoer_EchoServerStreamStream) error {
+	// mark the echoed body when a deadline propagated to the handler.
+	// asserted by the deadline e2e test.
+	if _, hasDeadline := strm.Context().Deadline(); hasDeadline {
+		msg = &EchoMsg{Body: msg.GetBody() + " [deadline]"}
+	}
 	// send 5 responses, with a 200ms delay for each
 	responses := 5
 	tkr := time.NewTicker(time.Millisecond * 200)
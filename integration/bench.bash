@@ -0,0 +1,35 @@
+#!/bin/bash
+set -eo pipefail
+
+unset GOOS
+unset GOARCH
+
+echo "Compiling ts..."
+../node_modules/.bin/esbuild bench.ts --bundle --platform=node --outfile=bench.js
+
+echo "Compiling go..."
+go build -o integration -v ./
+
+echo "Starting server with pprof..."
+./integration -pprof localhost:6060 &
+PID=$!
+
+function cleanup {
+    kill -9 ${PID}
+}
+trap cleanup EXIT
+
+sleep 1
+
+echo "Capturing 10s cpu profile while the bench runs..."
+curl -s -o pprof.cpu.pb.gz "http://localhost:6060/debug/pprof/profile?seconds=10" &
+CURL_PID=$!
+
+pushd ../
+echo "Starting bench client..."
+node ./integration/bench.js
+popd
+
+wait ${CURL_PID}
+echo "CPU profile written to integration/pprof.cpu.pb.gz"
+echo "Inspect with: go tool pprof pprof.cpu.pb.gz"
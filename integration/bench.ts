@@ -0,0 +1,129 @@
+import type { Client } from '../srpc/index.js'
+import { WebSocketConn } from '../srpc/websocket.js'
+import { EchoerClientImpl, EchoMsg } from '../echo/echo.pb.js'
+import { pushable } from 'it-pushable'
+import WebSocket from 'isomorphic-ws'
+
+// benchResult summarizes one benchmark run.
+interface BenchResult {
+  name: string
+  msgs: number
+  seconds: number
+  msgsPerSec: number
+  p50Ms: number
+  p99Ms: number
+}
+
+// percentile returns the p-th percentile of the sorted latency list.
+function percentile(sorted: number[], p: number): number {
+  if (sorted.length === 0) {
+    return 0
+  }
+  const idx = Math.min(
+    sorted.length - 1,
+    Math.ceil((p / 100) * sorted.length) - 1
+  )
+  return sorted[Math.max(0, idx)]
+}
+
+// buildResult computes the summary from per-message latencies.
+function buildResult(
+  name: string,
+  msgs: number,
+  elapsedMs: number,
+  latenciesMs: number[]
+): BenchResult {
+  const sorted = latenciesMs.slice().sort((a, b) => a - b)
+  const seconds = elapsedMs / 1000
+  return {
+    name,
+    msgs,
+    seconds,
+    msgsPerSec: msgs / seconds,
+    p50Ms: percentile(sorted, 50),
+    p99Ms: percentile(sorted, 99),
+  }
+}
+
+// printResult prints the summary in a stable one-line format.
+function printResult(result: BenchResult) {
+  console.log(
+    `${result.name}: ${result.msgs} msgs in ${result.seconds.toFixed(2)}s | ` +
+      `${result.msgsPerSec.toFixed(0)} msgs/sec | ` +
+      `p50 ${result.p50Ms.toFixed(2)}ms | p99 ${result.p99Ms.toFixed(2)}ms`
+  )
+}
+
+// nowMs returns a monotonic timestamp in milliseconds.
+function nowMs(): number {
+  return Number(process.hrtime.bigint()) / 1e6
+}
+
+// benchUnary drives sequential unary Echo calls.
+async function benchUnary(client: Client, iters: number): Promise<BenchResult> {
+  const demoServiceClient = new EchoerClientImpl(client)
+  const latencies: number[] = []
+  const started = nowMs()
+  for (let i = 0; i < iters; i++) {
+    const t0 = nowMs()
+    await demoServiceClient.Echo({ body: 'bench message' })
+    latencies.push(nowMs() - t0)
+  }
+  return buildResult('unary echo', iters, nowMs() - started, latencies)
+}
+
+// benchStreaming drives ping-pong messages over one bidi stream.
+async function benchStreaming(
+  client: Client,
+  msgs: number
+): Promise<BenchResult> {
+  const demoServiceClient = new EchoerClientImpl(client)
+  const requests = pushable<EchoMsg>({ objectMode: true })
+  const responses = demoServiceClient.EchoBidiStream(requests)
+  const latencies: number[] = []
+  const started = nowMs()
+  let sentAt = nowMs()
+  requests.push({ body: 'bench message' })
+  let received = 0
+  for await (const msg of responses) {
+    if (msg.body === 'hello from server') {
+      // server greeting, not an echo.
+      continue
+    }
+    latencies.push(nowMs() - sentAt)
+    received++
+    if (received >= msgs) {
+      requests.end()
+      break
+    }
+    sentAt = nowMs()
+    requests.push({ body: 'bench message' })
+  }
+  return buildResult('streaming echo', received, nowMs() - started, latencies)
+}
+
+async function runBench() {
+  const addr = 'ws://localhost:5000/demo'
+  const unaryIters = parseInt(process.env.BENCH_UNARY_ITERS || '2000', 10)
+  const streamMsgs = parseInt(process.env.BENCH_STREAM_MSGS || '5000', 10)
+
+  console.log(`Connecting to ${addr}`)
+  const ws = new WebSocket(addr)
+  const channel = new WebSocketConn(ws, 'outbound')
+  const client = channel.buildClient()
+
+  console.log(`Running unary bench: ${unaryIters} calls...`)
+  printResult(await benchUnary(client, unaryIters))
+
+  console.log(`Running streaming bench: ${streamMsgs} msgs...`)
+  printResult(await benchStreaming(client, streamMsgs))
+}
+
+runBench()
+  .then(() => {
+    process.exit(0)
+  })
+  .catch((err) => {
+    console.error(err)
+    process.exit(1)
+  })
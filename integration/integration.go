@@ -1,15 +1,22 @@
 package main
 
 import (
+	"flag"
 	"fmt"
 	"net/http"
+	_ "net/http/pprof"
 
 	"github.com/aperturerobotics/starpc/echo"
 	"github.com/aperturerobotics/starpc/srpc"
 	"github.com/sirupsen/logrus"
 )
 
+// pprofAddr serves net/http/pprof for profiling the server under load.
+var pprofAddr = flag.String("pprof", "", "if set, serve net/http/pprof on this address")
+
 func main() {
+	flag.Parse()
+
 	mux := srpc.NewMux()
 	echoServer := echo.NewEchoServer(mux)
 	if err := echo.SRPCRegisterEchoer(mux, echoServer); err != nil {
@@ -22,6 +29,13 @@ func main() {
 		logrus.Fatal(err.Error())
 	}
 
+	if *pprofAddr != "" {
+		go func() {
+			fmt.Printf("pprof listening on %s\n", *pprofAddr)
+			_ = http.ListenAndServe(*pprofAddr, nil)
+		}()
+	}
+
 	fmt.Print("listening on :5000\n")
 	if err := http.ListenAndServe(":5000", server); err != nil {
 		logrus.Fatal(err.Error())
@@ -27,8 +27,12 @@ func NewSRPCIntegrationServiceClient(cc srpc.Client) SRPCIntegrationServiceClien
 
 func (c *srpcIntegrationServiceClient) SRPCClient() srpc.Client { return c.cc }
 
+var (
+	srpcIntegrationService_RpcStreamCallStartPrefix = srpc.MarshalCallStartPrefix("main.IntegrationService", "RpcStream")
+)
+
 func (c *srpcIntegrationServiceClient) RpcStream(ctx context.Context) (SRPCIntegrationService_RpcStreamClient, error) {
-	stream, err := c.cc.NewStream(ctx, "main.IntegrationService", "RpcStream", nil)
+	stream, err := srpc.NewStreamWithPrefix(ctx, c.cc, srpcIntegrationService_RpcStreamCallStartPrefix, "main.IntegrationService", "RpcStream", nil)
 	if err != nil {
 		return nil, err
 	}
@@ -0,0 +1,152 @@
+package rpcstream
+
+import (
+	"context"
+	"sync"
+	"sync/atomic"
+
+	"github.com/aperturerobotics/starpc/srpc"
+	"github.com/pkg/errors"
+)
+
+// CachedRpcStreamGetter wraps a RpcStreamGetter with a read-mostly cache.
+//
+// the wrapped getter resolves each component id once; later streams for
+// the same component hit the cache without calling it again. errors and
+// nil muxes are not cached. Invalidate drops an entry when the component
+// behind it is replaced or removed.
+type CachedRpcStreamGetter struct {
+	// getter resolves uncached component ids.
+	getter RpcStreamGetter
+	// mtx guards muxes
+	mtx sync.RWMutex
+	// muxes contains the resolved muxes keyed by component id.
+	muxes map[string]srpc.Mux
+}
+
+// NewCachedRpcStreamGetter constructs a cache around a getter.
+func NewCachedRpcStreamGetter(getter RpcStreamGetter) *CachedRpcStreamGetter {
+	return &CachedRpcStreamGetter{
+		getter: getter,
+		muxes:  make(map[string]srpc.Mux),
+	}
+}
+
+// GetMux returns the mux for the component id, consulting the cache first.
+//
+// GetMux matches the RpcStreamGetter signature: pass it to HandleRpcStream.
+// concurrent misses for the same id may call the wrapped getter more than
+// once; the first result stored wins.
+func (c *CachedRpcStreamGetter) GetMux(ctx context.Context, componentID string) (srpc.Mux, error) {
+	c.mtx.RLock()
+	mux, ok := c.muxes[componentID]
+	c.mtx.RUnlock()
+	if ok {
+		return mux, nil
+	}
+
+	// resolve outside the lock: the getter may block.
+	mux, err := c.getter(ctx, componentID)
+	if err != nil || mux == nil {
+		return mux, err
+	}
+
+	c.mtx.Lock()
+	if exist, ok := c.muxes[componentID]; ok {
+		mux = exist
+	} else {
+		c.muxes[componentID] = mux
+	}
+	c.mtx.Unlock()
+	return mux, nil
+}
+
+// Invalidate drops the cached mux for a component id, if any.
+func (c *CachedRpcStreamGetter) Invalidate(componentID string) {
+	c.mtx.Lock()
+	delete(c.muxes, componentID)
+	c.mtx.Unlock()
+}
+
+// Clear drops all cached muxes.
+func (c *CachedRpcStreamGetter) Clear() {
+	c.mtx.Lock()
+	c.muxes = make(map[string]srpc.Mux)
+	c.mtx.Unlock()
+}
+
+// NewRpcStreamOpenStreamPipelined constructs an OpenStream function which
+// skips waiting for the handshake ack once the component has been acked.
+//
+// the first open performs the full init/ack round trip. later opens send
+// the init packet and return immediately, verifying the ack when the
+// first packet arrives on the stream instead. this removes a full round
+// trip from every nested stream open after the first.
+func NewRpcStreamOpenStreamPipelined(rpcCaller RpcStreamCaller, componentID string) srpc.OpenStreamFunc {
+	var acked int32
+	return func(ctx context.Context, msgHandler srpc.PacketHandler, closeHandler srpc.CloseHandler) (srpc.Writer, error) {
+		if atomic.LoadInt32(&acked) == 0 {
+			// first open: wait for the ack before proceeding.
+			rw, err := OpenRpcStream(ctx, rpcCaller, componentID)
+			if err != nil {
+				return nil, err
+			}
+			atomic.StoreInt32(&acked, 1)
+			go rw.ReadPump(msgHandler, closeHandler)
+			return rw, nil
+		}
+
+		// the component was acked before: pipeline the init packet and
+		// check the ack on the first receive instead of blocking here.
+		rpcStream, err := rpcCaller(ctx)
+		if err != nil {
+			return nil, err
+		}
+		err = rpcStream.Send(&RpcStreamPacket{
+			Body: &RpcStreamPacket_Init{
+				Init: &RpcStreamInit{ComponentId: componentID},
+			},
+		})
+		if err != nil {
+			_ = rpcStream.Close()
+			return nil, err
+		}
+		srw := NewRpcStreamReadWriter(&deferredAckStream{RpcStream: rpcStream})
+		rw := srpc.NewPacketReadWriter(srw)
+		go rw.ReadPump(msgHandler, closeHandler)
+		return rw, nil
+	}
+}
+
+// deferredAckStream checks the pipelined handshake ack on first receive.
+type deferredAckStream struct {
+	RpcStream
+	// acked indicates the ack was received & checked.
+	// only the read pump calls Recv: no locking needed.
+	acked bool
+}
+
+// Recv consumes the ack packet before returning data packets.
+func (s *deferredAckStream) Recv() (*RpcStreamPacket, error) {
+	if !s.acked {
+		pkt, err := s.RpcStream.Recv()
+		if err != nil {
+			return nil, err
+		}
+		ack, ok := pkt.GetBody().(*RpcStreamPacket_Ack)
+		if !ok {
+			return nil, errors.New("expected ack packet")
+		}
+		if errStr := ack.Ack.GetError(); errStr != "" {
+			return nil, errors.Errorf("remote: %s", errStr)
+		}
+		s.acked = true
+	}
+	return s.RpcStream.Recv()
+}
+
+// _ is a type assertion
+var _ RpcStreamGetter = (&CachedRpcStreamGetter{}).GetMux
+
+// _ is a type assertion
+var _ RpcStream = (*deferredAckStream)(nil)
@@ -25,6 +25,18 @@ type RpcStreamCaller func(ctx context.Context) (RpcStream, error)
 
 // OpenRpcStream opens a RPC stream with a remote.
 func OpenRpcStream(ctx context.Context, rpcCaller RpcStreamCaller, componentID string) (*srpc.PacketReaderWriter, error) {
+	rpcStream, err := openRpcStream(ctx, rpcCaller, componentID)
+	if err != nil {
+		return nil, err
+	}
+
+	// ready
+	rw := NewRpcStreamReadWriter(rpcStream)
+	return srpc.NewPacketReadWriter(rw), nil
+}
+
+// openRpcStream starts the rpc stream call and performs the init/ack handshake.
+func openRpcStream(ctx context.Context, rpcCaller RpcStreamCaller, componentID string) (RpcStream, error) {
 	// open the rpc stream
 	rpcStream, err := rpcCaller(ctx)
 	if err != nil {
@@ -61,9 +73,7 @@ func OpenRpcStream(ctx context.Context, rpcCaller RpcStreamCaller, componentID s
 		return nil, err
 	}
 
-	// ready
-	rw := NewRpcStreamReadWriter(rpcStream)
-	return srpc.NewPacketReadWriter(rw), nil
+	return rpcStream, nil
 }
 
 // NewRpcStreamOpenStream constructs an OpenStream function with a RpcStream.
@@ -83,20 +93,78 @@ func NewRpcStreamOpenStream(rpcCaller RpcStreamCaller, componentID string) srpc.
 	}
 }
 
+// NewRpcStreamOpenStreamDirect constructs an OpenStream function which
+// uses flattened framing: each inner Packet rides as a single
+// RpcStreamPacket data frame, without the inner length prefix or the
+// byte-stream reassembly layer.
+//
+// the remote must handle the stream with HandleRpcStreamDirect.
+func NewRpcStreamOpenStreamDirect(rpcCaller RpcStreamCaller, componentID string) srpc.OpenStreamFunc {
+	return func(ctx context.Context, msgHandler srpc.PacketHandler, closeHandler srpc.CloseHandler) (srpc.Writer, error) {
+		// open the stream
+		rpcStream, err := openRpcStream(ctx, rpcCaller, componentID)
+		if err != nil {
+			return nil, err
+		}
+
+		// start the read pump
+		go readRpcStreamPump(rpcStream, msgHandler, closeHandler)
+
+		// return the writer
+		return NewRpcStreamWriter(rpcStream), nil
+	}
+}
+
 // HandleRpcStream handles an incoming RPC stream (remote is the initiator).
 func HandleRpcStream(stream RpcStream, getter RpcStreamGetter) error {
+	mux, err := handleRpcStreamInit(stream, getter)
+	if err != nil {
+		return err
+	}
+
+	// handle the rpc
+	ctx := stream.Context()
+	serverRPC := srpc.NewServerRPC(ctx, mux)
+	srw := NewRpcStreamReadWriter(stream)
+	prw := srpc.NewPacketReadWriter(srw)
+	serverRPC.SetWriter(prw)
+	go prw.ReadPump(serverRPC.HandlePacket, serverRPC.HandleStreamClose)
+	return serverRPC.Wait(ctx)
+}
+
+// HandleRpcStreamDirect handles an incoming RPC stream with flattened
+// framing: each RpcStreamPacket data frame holds exactly one inner
+// Packet, without the inner length prefix.
+//
+// the remote must open the stream with NewRpcStreamOpenStreamDirect.
+func HandleRpcStreamDirect(stream RpcStream, getter RpcStreamGetter) error {
+	mux, err := handleRpcStreamInit(stream, getter)
+	if err != nil {
+		return err
+	}
+
+	// handle the rpc
+	ctx := stream.Context()
+	serverRPC := srpc.NewServerRPC(ctx, mux)
+	serverRPC.SetWriter(NewRpcStreamWriter(stream))
+	go readRpcStreamPump(stream, serverRPC.HandlePacket, serverRPC.HandleStreamClose)
+	return serverRPC.Wait(ctx)
+}
+
+// handleRpcStreamInit reads the init packet, looks up the mux & sends the ack.
+func handleRpcStreamInit(stream RpcStream, getter RpcStreamGetter) (srpc.Mux, error) {
 	// Read the "init" packet.
 	initPkt, err := stream.Recv()
 	if err != nil {
-		return err
+		return nil, err
 	}
 	initInner, ok := initPkt.GetBody().(*RpcStreamPacket_Init)
 	if !ok || initInner.Init == nil {
-		return errors.New("expected init packet")
+		return nil, errors.New("expected init packet")
 	}
 	componentID := initInner.Init.GetComponentId()
 	if componentID == "" {
-		return errors.New("invalid init packet: empty component id")
+		return nil, errors.New("invalid init packet: empty component id")
 	}
 
 	// lookup the server for this component id
@@ -117,19 +185,13 @@ func HandleRpcStream(stream RpcStream, getter RpcStreamGetter) error {
 		},
 	})
 	if err != nil {
-		return err
+		return nil, err
 	}
 	if sendErr != nil {
-		return sendErr
+		return nil, sendErr
 	}
 
-	// handle the rpc
-	serverRPC := srpc.NewServerRPC(ctx, mux)
-	srw := NewRpcStreamReadWriter(stream)
-	prw := srpc.NewPacketReadWriter(srw)
-	serverRPC.SetWriter(prw)
-	go prw.ReadPump(serverRPC.HandlePacket, serverRPC.HandleStreamClose)
-	return serverRPC.Wait(ctx)
+	return mux, nil
 }
 
 // RpcStreamReadWriter reads and writes a buffered RpcStream.
@@ -206,5 +268,96 @@ func (r *RpcStreamReadWriter) Close() error {
 	return r.stream.Close()
 }
 
+// RpcStreamWriter implements srpc.Writer over a RpcStream with
+// flattened framing: the marshaled inner Packet bytes ride directly as
+// the RpcStreamPacket data field, with no second length prefix.
+type RpcStreamWriter struct {
+	// stream is the RpcStream
+	stream RpcStream
+}
+
+// NewRpcStreamWriter constructs a new RpcStreamWriter.
+func NewRpcStreamWriter(stream RpcStream) *RpcStreamWriter {
+	return &RpcStreamWriter{stream: stream}
+}
+
+// WritePacket writes a packet to the remote.
+func (r *RpcStreamWriter) WritePacket(p *srpc.Packet) error {
+	data, err := p.MarshalVT()
+	if err != nil {
+		return err
+	}
+	return r.stream.Send(&RpcStreamPacket{
+		Body: &RpcStreamPacket_Data{
+			Data: data,
+		},
+	})
+}
+
+// WritePacketPooled writes a packet to the remote.
+//
+// the outer stream serializes the frame before Send returns, so no
+// pooled scratch buffer is needed here.
+func (r *RpcStreamWriter) WritePacketPooled(p *srpc.Packet) error {
+	return r.WritePacket(p)
+}
+
+// WritePackets writes a batch of packets.
+func (r *RpcStreamWriter) WritePackets(pkts []*srpc.Packet) error {
+	for _, p := range pkts {
+		if err := r.WritePacket(p); err != nil {
+			return err
+		}
+	}
+	return nil
+}
+
+// Close closes the writer.
+func (r *RpcStreamWriter) Close() error {
+	return r.stream.Close()
+}
+
+// readRpcStreamPump reads flattened packets to the handler.
+//
+// calls the closed handler when the stream closes or errors.
+func readRpcStreamPump(stream RpcStream, cb srpc.PacketHandler, closed srpc.CloseHandler) {
+	err := readRpcStreamToHandler(stream, cb)
+	if closed != nil {
+		closed(err)
+	}
+}
+
+// readRpcStreamToHandler reads flattened packets to the given handler.
+func readRpcStreamToHandler(stream RpcStream, cb srpc.PacketHandler) error {
+	for {
+		pkt, err := stream.Recv()
+		if err != nil {
+			if err == io.EOF || err == context.Canceled {
+				// closed
+				return nil
+			}
+			return err
+		}
+		data := pkt.GetData()
+		if len(data) == 0 {
+			continue
+		}
+
+		// decode and emit the packet, returning it to the pool after.
+		npkt := srpc.GetPacket()
+		err = npkt.UnmarshalVT(data)
+		if err == nil {
+			err = cb(npkt)
+		}
+		srpc.ReleasePacket(npkt)
+		if err != nil {
+			return err
+		}
+	}
+}
+
 // _ is a type assertion
 var _ io.ReadWriteCloser = (*RpcStreamReadWriter)(nil)
+
+// _ is a type assertion
+var _ srpc.Writer = (*RpcStreamWriter)(nil)
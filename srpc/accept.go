@@ -2,28 +2,113 @@ package srpc
 
 import (
 	"context"
+	"io"
 	"net"
 )
 
 // AcceptMuxedListener accepts incoming connections from a net.Listener.
 //
-// Uses the default mplex muxer.
+// Uses the default mplex muxer. the muxer handshake and stream handling
+// run off the accept path in a per-connection goroutine, so a slow
+// handshake does not delay the next Accept.
 func AcceptMuxedListener(ctx context.Context, lis net.Listener, srv *Server) error {
+	return acceptMuxedConns(ctx, lis, srv)
+}
+
+// AcceptMuxedListenerWorkers runs workers concurrent accept loops on
+// the listener, sharding accept load across goroutines.
+//
+// concurrent Accept calls are safe on net.Listener. returns the first
+// accept error; the remaining workers exit when the listener closes.
+// workers <= 1 is equivalent to AcceptMuxedListener.
+func AcceptMuxedListenerWorkers(ctx context.Context, lis net.Listener, srv *Server, workers int) error {
+	if workers <= 1 {
+		return acceptMuxedConns(ctx, lis, srv)
+	}
+	errCh := make(chan error, workers)
+	for i := 0; i < workers; i++ {
+		go func() {
+			errCh <- acceptMuxedConns(ctx, lis, srv)
+		}()
+	}
+	select {
+	case <-ctx.Done():
+		return context.Canceled
+	case err := <-errCh:
+		return err
+	}
+}
+
+// AcceptMuxedListenerNegotiate accepts incoming connections from a
+// net.Listener, negotiating the stream muxer per connection.
+//
+// each client writes a single leading muxer type byte, see
+// NewClientWithNegotiatedMuxer. the negotiation and muxer handshake run
+// off the accept path in a per-connection goroutine.
+func AcceptMuxedListenerNegotiate(ctx context.Context, lis net.Listener, srv *Server) error {
 	for {
 		nc, err := lis.Accept()
 		if err != nil {
 			return err
 		}
 
-		mc, err := NewMuxedConn(nc, false)
+		go func() {
+			var muxerType [1]byte
+			if _, err := io.ReadFull(nc, muxerType[:]); err != nil {
+				_ = nc.Close()
+				return
+			}
+			mc, err := NewMuxedConnWithType(nc, false, MuxerType(muxerType[0]))
+			if err != nil {
+				_ = nc.Close()
+				return
+			}
+			if err := srv.AcceptMuxedConn(ctx, mc); err != nil {
+				_ = nc.Close()
+			}
+		}()
+	}
+}
+
+// acceptMuxedConns accepts muxed connections from the listener.
+// the muxer handshake runs off the accept path.
+func acceptMuxedConns(ctx context.Context, lis net.Listener, srv *Server) error {
+	for {
+		nc, err := lis.Accept()
 		if err != nil {
-			_ = nc.Close()
-			continue
+			return err
 		}
 
-		if err := srv.AcceptMuxedConn(ctx, mc); err != nil {
-			_ = nc.Close()
-			continue
+		go func() {
+			mc, err := NewMuxedConn(nc, false)
+			if err != nil {
+				_ = nc.Close()
+				return
+			}
+			if err := srv.AcceptMuxedConn(ctx, mc); err != nil {
+				_ = nc.Close()
+			}
+		}()
+	}
+}
+
+// AcceptPacketListener accepts incoming connections from a net.Listener
+// and serves each with a shared packet read loop.
+//
+// every connection is handled with HandlePacketStream: RPCs are
+// multiplexed by rpc id over the single stream, so the goroutine count
+// scales with connections rather than with streams. the remote must
+// connect with NewClientWithPacketStream.
+func AcceptPacketListener(ctx context.Context, lis net.Listener, srv *Server) error {
+	for {
+		nc, err := lis.Accept()
+		if err != nil {
+			return err
 		}
+
+		go func() {
+			defer nc.Close()
+			_ = srv.HandlePacketStream(ctx, nc)
+		}()
 	}
 }
@@ -30,6 +30,9 @@ export class BroadcastChannelDuplex<T> implements Duplex<T> {
   }
 
   // _createSink initializes the sink field.
+  // note: BroadcastChannel.postMessage has no transfer list, messages
+  // are always structured-cloned. use MessagePortConn with the transfer
+  // option for zero-copy messaging between threads.
   private _createSink(): Sink<T> {
     return async (source) => {
       for await (const msg of source) {
@@ -0,0 +1,94 @@
+package srpc
+
+// CallStartPrefix contains the pre-marshaled rpc_service & rpc_method
+// fields of a CallStart packet.
+//
+// the service & method strings for a generated client are known at
+// codegen time: generated stubs compute the prefix once at init with
+// MarshalCallStartPrefix and ClientRPC.Start splices in the per-call
+// fields instead of re-encoding the identical strings on every call.
+type CallStartPrefix []byte
+
+// MarshalCallStartPrefix pre-marshals the CallStart service & method fields.
+//
+// called once at init by generated code, see CallStartPrefix.
+func MarshalCallStartPrefix(service, method string) CallStartPrefix {
+	buf := make([]byte, 0, len(service)+len(method)+4)
+	buf = append(buf, 0x0a) // rpc_service, field 1
+	buf = appendUvarint(buf, uint64(len(service)))
+	buf = append(buf, service...)
+	buf = append(buf, 0x12) // rpc_method, field 2
+	buf = appendUvarint(buf, uint64(len(method)))
+	buf = append(buf, method...)
+	return CallStartPrefix(buf)
+}
+
+// marshalCallStartPacket assembles the full Packet bytes for a CallStart
+// from the pre-marshaled prefix and the per-call fields.
+//
+// the fields append after the prefix in field number order, producing
+// the same canonical encoding as marshaling the CallStart message.
+func marshalCallStartPacket(
+	prefix CallStartPrefix,
+	data []byte,
+	dataIsZero bool,
+	dataCompress uint32,
+	deadlineUnixMs int64,
+) []byte {
+	// compute the CallStart body size
+	bodyLen := len(prefix)
+	if len(data) != 0 {
+		bodyLen += 1 + uvarintLen(uint64(len(data))) + len(data)
+	}
+	if dataIsZero {
+		bodyLen += 2
+	}
+	if dataCompress != 0 {
+		bodyLen += 1 + uvarintLen(uint64(dataCompress))
+	}
+	if deadlineUnixMs != 0 {
+		bodyLen += 1 + uvarintLen(uint64(deadlineUnixMs))
+	}
+
+	// assemble the Packet: call_start is field 1 of the body oneof.
+	buf := make([]byte, 0, 1+uvarintLen(uint64(bodyLen))+bodyLen)
+	buf = append(buf, 0x0a) // call_start, field 1
+	buf = appendUvarint(buf, uint64(bodyLen))
+	buf = append(buf, prefix...)
+	if len(data) != 0 {
+		buf = append(buf, 0x1a) // data, field 3
+		buf = appendUvarint(buf, uint64(len(data)))
+		buf = append(buf, data...)
+	}
+	if dataIsZero {
+		buf = append(buf, 0x20, 0x01) // data_is_zero, field 4
+	}
+	if dataCompress != 0 {
+		buf = append(buf, 0x28) // data_compress, field 5
+		buf = appendUvarint(buf, uint64(dataCompress))
+	}
+	if deadlineUnixMs != 0 {
+		buf = append(buf, 0x30) // deadline_unix_ms, field 6
+		buf = appendUvarint(buf, uint64(deadlineUnixMs))
+	}
+	return buf
+}
+
+// appendUvarint appends v as a protobuf varint.
+func appendUvarint(buf []byte, v uint64) []byte {
+	for v >= 0x80 {
+		buf = append(buf, byte(v)|0x80)
+		v >>= 7
+	}
+	return append(buf, byte(v))
+}
+
+// uvarintLen returns the encoded size of v as a protobuf varint.
+func uvarintLen(v uint64) int {
+	n := 1
+	for v >= 0x80 {
+		v >>= 7
+		n++
+	}
+	return n
+}
@@ -0,0 +1,70 @@
+package srpc
+
+import (
+	"context"
+)
+
+// directClient implements Client by invoking the server mux in-process.
+//
+// calls never cross the packet layer: messages are handed between the
+// two ends of a directStream without serialization. messages passed to
+// MsgSend must not be modified after sending.
+type directClient struct {
+	// server is the server to dispatch calls to.
+	server *Server
+}
+
+// NewDirectClient constructs a Client which dispatches calls directly
+// to a Server in the same process, bypassing serialization and the
+// packet framing layer entirely.
+//
+// the recommended loopback for same-process client/server pairs, see
+// NewServerPipe for the serializing equivalent.
+func NewDirectClient(server *Server) Client {
+	return &directClient{server: server}
+}
+
+// Invoke executes a unary RPC with the remote.
+func (c *directClient) Invoke(ctx context.Context, service, method string, in, out Message) error {
+	strm := c.startCall(ctx, service, method)
+	defer strm.Close()
+	if err := strm.MsgSend(in); err != nil {
+		return err
+	}
+	return strm.MsgRecv(out)
+}
+
+// NewStream starts a streaming RPC with the remote & returns the stream.
+// firstMsg is optional.
+func (c *directClient) NewStream(ctx context.Context, service, method string, firstMsg Message) (Stream, error) {
+	strm := c.startCall(ctx, service, method)
+	if firstMsg != nil {
+		if err := strm.MsgSend(firstMsg); err != nil {
+			_ = strm.Close()
+			return nil, err
+		}
+	}
+	return strm, nil
+}
+
+// startCall invokes the method on the mux in a separate goroutine.
+// returns the client end of the direct stream pair.
+func (c *directClient) startCall(ctx context.Context, service, method string) *directStream {
+	clientStrm, serverStrm := newDirectStreamPair(ctx)
+	stats := newRPCStats(service, method, true)
+	go func() {
+		ok, err := c.server.GetMux().InvokeMethod(service, method, serverStrm)
+		if err == nil && !ok {
+			err = ErrUnimplemented
+		}
+		stats.complete(err)
+		// signal completion to the client end, like the final
+		// call data packet over a transport.
+		serverStrm.closeRemote(err)
+		serverStrm.ctxCancel()
+	}()
+	return clientStrm
+}
+
+// _ is a type assertion
+var _ Client = ((*directClient)(nil))
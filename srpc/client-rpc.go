@@ -20,16 +20,56 @@ type ClientRPC struct {
 	service string
 	// method is the rpc method
 	method string
-	// dataCh contains queued data packets.
-	// closed when the client closes the channel.
-	dataCh chan []byte
-	// dataChClosed is a flag set after dataCh is closed.
+	// dataQueue contains queued data packets.
+	// closed when the remote completes the rpc.
+	dataQueue *recvQueue
+	// dataClosed is a flag set after dataQueue is closed.
 	// controlled by HandlePacket.
-	dataChClosed bool
+	dataClosed bool
 	// serverErr is an error set by the client.
-	// before dataCh is closed, managed by HandlePacket.
-	// immutable after dataCh is closed.
+	// before dataQueue is closed, managed by HandlePacket.
+	// immutable after dataQueue is closed.
 	serverErr error
+	// stats tracks rpc events, nil if no stats handler is registered.
+	stats *rpcStats
+	// compressType is the compression type offered in CallStart.
+	compressType uint32
+	// compressCodec compresses message data, nil if disabled.
+	compressCodec CompressionCodec
+	// compressErr is set if the compression type lookup failed.
+	compressErr error
+	// maxRecvBytes bounds the total received data bytes. 0 = unbounded.
+	maxRecvBytes int
+	// recvBytes counts the total received data bytes.
+	recvBytes int
+	// unary enables single-message accumulation mode, see setUnary.
+	unary bool
+	// unaryDone indicates the single unary message was queued.
+	unaryDone bool
+	// unaryBuf accumulates chunked unary message data.
+	unaryBuf []byte
+	// callStartPrefix is the pre-marshaled service & method fields.
+	// nil unless set by generated code, see CallStartPrefix.
+	callStartPrefix CallStartPrefix
+}
+
+// maxResponseSizeContextKey is the context key for the response size limit.
+type maxResponseSizeContextKey struct{}
+
+// WithMaxResponseSize attaches a per-call response size limit to the context.
+//
+// client calls started with the returned context fail with
+// ErrResponseTooLarge once the total received data bytes exceed
+// maxBytes, bounding the memory a misbehaving server can force the
+// client to hold. zero means unbounded.
+func WithMaxResponseSize(ctx context.Context, maxBytes int) context.Context {
+	return context.WithValue(ctx, maxResponseSizeContextKey{}, maxBytes)
+}
+
+// maxResponseSizeFromContext returns the response size limit from the context.
+func maxResponseSizeFromContext(ctx context.Context) int {
+	maxBytes, _ := ctx.Value(maxResponseSizeContextKey{}).(int)
+	return maxBytes
 }
 
 // NewClientRPC constructs a new ClientRPC session and writes CallStart.
@@ -38,10 +78,14 @@ type ClientRPC struct {
 // must call Start after creating the RPC object.
 func NewClientRPC(ctx context.Context, service, method string) *ClientRPC {
 	rpc := &ClientRPC{
-		service: service,
-		method:  method,
-		dataCh:  make(chan []byte, 5),
+		service:   service,
+		method:    method,
+		dataQueue: newRecvQueue(),
+		stats:     newRPCStats(service, method, true),
 	}
+	rpc.maxRecvBytes = maxResponseSizeFromContext(ctx)
+	rpc.compressType = compressionFromContext(ctx)
+	rpc.compressCodec, rpc.compressErr = getCompressionCodec(rpc.compressType)
 	rpc.ctx, rpc.ctxCancel = context.WithCancel(ctx)
 	return rpc
 }
@@ -56,34 +100,82 @@ func (r *ClientRPC) Start(writer Writer, writeFirstMsg bool, firstMsg []byte) er
 	default:
 	}
 	r.writer = writer
+	if r.compressErr != nil {
+		r.Close()
+		return r.compressErr
+	}
 	var firstMsgEmpty bool
 	if writeFirstMsg {
 		firstMsgEmpty = len(firstMsg) == 0
+		if r.compressCodec != nil && !firstMsgEmpty {
+			var err error
+			if firstMsg, err = r.compressCodec.Compress(firstMsg); err != nil {
+				r.Close()
+				return err
+			}
+		}
 	} else {
 		firstMsg = nil
 	}
-	pkt := NewCallStartPacket(r.service, r.method, firstMsg, firstMsgEmpty)
-	if err := writer.WritePacket(pkt); err != nil {
+	// propagate the call deadline so the server can stop early.
+	var deadlineUnixMs int64
+	if deadline, ok := r.ctx.Deadline(); ok {
+		deadlineUnixMs = deadline.UnixMilli()
+	}
+	var err error
+	if raw, ok := writer.(RawWriter); ok && r.callStartPrefix != nil {
+		// splice the pre-marshaled service & method prefix.
+		data := marshalCallStartPacket(r.callStartPrefix, firstMsg, firstMsgEmpty, r.compressType, deadlineUnixMs)
+		err = raw.WriteRawPacket(data)
+	} else {
+		pkt := NewCallStartPacket(r.service, r.method, firstMsg, firstMsgEmpty)
+		pkt.GetCallStart().DataCompress = r.compressType
+		pkt.GetCallStart().DeadlineUnixMs = deadlineUnixMs
+		err = writer.WritePacket(pkt)
+	}
+	if err != nil {
 		r.Close()
 		return err
 	}
+	if writeFirstMsg {
+		r.stats.sentMsg(len(firstMsg))
+	}
 	return nil
 }
 
+// setCallStartPrefix sets the pre-marshaled service & method fields.
+// must be called before Start. see CallStartPrefix.
+func (r *ClientRPC) setCallStartPrefix(prefix CallStartPrefix) {
+	r.callStartPrefix = prefix
+}
+
+// setUnary enables single-message accumulation mode.
+//
+// intended for unary calls which consume exactly one message via
+// ReadOne: chunked fragments accumulate into a single buffer instead
+// of separate queue entries, and any data after the first complete
+// message is dropped rather than buffered unconsumed.
+// must be called before Start.
+func (r *ClientRPC) setUnary() {
+	r.unary = true
+}
+
 // ReadAll reads all returned Data packets and returns any error.
 // intended for use with unary rpcs.
 func (r *ClientRPC) ReadAll() ([][]byte, error) {
 	msgs := make([][]byte, 0, 1)
 	for {
-		select {
-		case <-r.ctx.Done():
-			return msgs, context.Canceled
-		case data, ok := <-r.dataCh:
-			if !ok {
-				return msgs, r.serverErr
-			}
-			msgs = append(msgs, data)
+		data, ok, err := r.dataQueue.popFull(r.ctx)
+		if err != nil {
+			return msgs, err
+		}
+		if !ok {
+			return msgs, r.serverErr
 		}
+		if data, err = r.decompress(data); err != nil {
+			return msgs, err
+		}
+		msgs = append(msgs, data)
 	}
 }
 
@@ -91,18 +183,25 @@ func (r *ClientRPC) ReadAll() ([][]byte, error) {
 //
 // returns io.EOF if the stream ended.
 func (r *ClientRPC) ReadOne() ([]byte, error) {
-	select {
-	case <-r.ctx.Done():
-		return nil, context.Canceled
-	case data, ok := <-r.dataCh:
-		if !ok {
-			if err := r.serverErr; err != nil {
-				return nil, err
-			}
-			return nil, io.EOF
+	data, ok, err := r.dataQueue.popFull(r.ctx)
+	if err != nil {
+		return nil, err
+	}
+	if !ok {
+		if err := r.serverErr; err != nil {
+			return nil, err
 		}
+		return nil, io.EOF
+	}
+	return r.decompress(data)
+}
+
+// decompress decompresses received message data when enabled.
+func (r *ClientRPC) decompress(data []byte) ([]byte, error) {
+	if r.compressCodec == nil || len(data) == 0 {
 		return data, nil
 	}
+	return r.compressCodec.Decompress(data)
 }
 
 // Context is canceled when the ClientRPC is no longer valid.
@@ -113,11 +212,13 @@ func (r *ClientRPC) Context() context.Context {
 // HandlePacketData handles an incoming unparsed message packet.
 // Not concurrency safe: use a mutex if calling concurrently.
 func (r *ClientRPC) HandlePacketData(data []byte) error {
-	pkt := &Packet{}
-	if err := pkt.UnmarshalVT(data); err != nil {
-		return err
+	pkt := GetPacket()
+	err := pkt.UnmarshalVT(data)
+	if err == nil {
+		err = r.HandlePacket(pkt)
 	}
-	return r.HandlePacket(pkt)
+	ReleasePacket(pkt)
+	return err
 }
 
 // HandleStreamClose handles the incoming stream closing w/ optional error.
@@ -155,15 +256,27 @@ func (r *ClientRPC) HandleCallStart(pkt *CallStart) error {
 
 // HandleCallData handles the call data packet.
 func (r *ClientRPC) HandleCallData(pkt *CallData) error {
-	if r.dataChClosed {
+	if r.dataClosed {
 		return ErrCompleted
 	}
 
 	if data := pkt.GetData(); len(data) != 0 || pkt.GetDataIsZero() {
-		select {
-		case <-r.ctx.Done():
-			return context.Canceled
-		case r.dataCh <- data:
+		r.recvBytes += len(data)
+		if r.maxRecvBytes != 0 && r.recvBytes > r.maxRecvBytes {
+			err := errors.Wrapf(ErrResponseTooLarge, "%d bytes exceeds limit of %d", r.recvBytes, r.maxRecvBytes)
+			r.serverErr = err
+			r.dataClosed = true
+			r.dataQueue.close()
+			r.stats.complete(err)
+			return err
+		}
+		if err := r.queueData(data, pkt.GetDataContinued()); err != nil {
+			return err
+		}
+		if pkt.GetDataContinued() {
+			r.stats.recvFragment(len(data))
+		} else {
+			r.stats.recvMsg(len(data))
 		}
 	}
 
@@ -174,16 +287,49 @@ func (r *ClientRPC) HandleCallData(pkt *CallData) error {
 	}
 
 	if complete {
-		r.dataChClosed = true
-		close(r.dataCh)
+		r.dataClosed = true
+		r.dataQueue.close()
+		r.stats.complete(r.serverErr)
 	}
 
 	return nil
 }
 
+// queueData queues incoming data for the consumer.
+//
+// in unary mode chunked fragments accumulate into a single buffer which
+// is queued once complete; extra messages after the first are dropped.
+func (r *ClientRPC) queueData(data []byte, continued bool) error {
+	if !r.unary {
+		return r.dataQueue.push(r.ctx, data, continued)
+	}
+	if r.unaryDone {
+		// the single unary response was already queued: drop extras.
+		return nil
+	}
+	if continued {
+		if len(r.unaryBuf)+len(data) > int(maxMessageSize) {
+			return errors.Errorf("chunked message size greater than maximum %v", maxMessageSize)
+		}
+		r.unaryBuf = append(r.unaryBuf, data...)
+		return nil
+	}
+	if r.unaryBuf != nil {
+		data = append(r.unaryBuf, data...)
+		r.unaryBuf = nil
+	}
+	r.unaryDone = true
+	return r.dataQueue.push(r.ctx, data, false)
+}
+
 // Close releases any resources held by the ClientRPC.
 // not concurrency safe with HandlePacket.
 func (r *ClientRPC) Close() {
+	if !r.dataClosed && r.writer != nil {
+		// proactively cancel the rpc on the remote.
+		_ = r.writer.WritePacket(NewCallCancelPacket())
+	}
+	r.stats.complete(r.serverErr)
 	r.ctxCancel()
 	_ = r.writer.Close()
 }
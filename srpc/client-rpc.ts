@@ -1,10 +1,12 @@
+import Long from 'long'
+
 import type { CallStart } from './rpcproto.pb.js'
 import { CommonRPC } from './common-rpc.js'
 
 // ClientRPC is an ongoing RPC from the client side.
 export class ClientRPC extends CommonRPC {
-  constructor(service: string, method: string) {
-    super()
+  constructor(service: string, method: string, highWaterMark?: number) {
+    super(highWaterMark)
     this.service = service
     this.method = method
   }
@@ -20,12 +22,15 @@ export class ClientRPC extends CommonRPC {
       rpcMethod: this.method,
       data: data || new Uint8Array(0),
       dataIsZero: !!data && data.length === 0,
+      dataCompress: 0,
+      deadlineUnixMs: Long.ZERO,
     }
     await this.writePacket({
       body: {
         $case: 'callStart',
         callStart,
       },
+      rpcId: Long.UZERO,
     })
   }
 
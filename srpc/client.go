@@ -24,10 +24,19 @@ type OpenStreamFunc = func(
 	closeHandler CloseHandler,
 ) (Writer, error)
 
+// Invoker executes unary RPCs with the remote.
+// Implemented by transports with a unary fast path, see PacketMux.
+type Invoker interface {
+	// Invoke executes a unary RPC with the remote.
+	Invoke(ctx context.Context, service, method string, in, out Message) error
+}
+
 // client implements Client with a transport.
 type client struct {
 	// openStream opens a new stream.
 	openStream OpenStreamFunc
+	// invoker is an optional fast path for unary calls.
+	invoker Invoker
 }
 
 // NewClient constructs a client with a OpenStreamFunc.
@@ -37,8 +46,51 @@ func NewClient(openStream OpenStreamFunc) Client {
 	}
 }
 
+// NewClientWithInvoker constructs a client with a OpenStreamFunc and an
+// Invoker used as the fast path for unary calls.
+func NewClientWithInvoker(openStream OpenStreamFunc, invoker Invoker) Client {
+	return &client{
+		openStream: openStream,
+		invoker:    invoker,
+	}
+}
+
+// InvokeWithPrefix executes a unary RPC using a pre-marshaled CallStart prefix.
+//
+// used by generated code, see CallStartPrefix. falls back to cc.Invoke
+// when cc is not the built-in client implementation.
+func InvokeWithPrefix(ctx context.Context, cc Client, prefix CallStartPrefix, service, method string, in, out Message) error {
+	c, ok := cc.(*client)
+	if !ok {
+		return cc.Invoke(ctx, service, method, in, out)
+	}
+	return c.invoke(ctx, prefix, service, method, in, out)
+}
+
+// NewStreamWithPrefix starts a streaming RPC using a pre-marshaled CallStart prefix.
+//
+// used by generated code, see CallStartPrefix. falls back to
+// cc.NewStream when cc is not the built-in client implementation.
+func NewStreamWithPrefix(ctx context.Context, cc Client, prefix CallStartPrefix, service, method string, firstMsg Message) (Stream, error) {
+	c, ok := cc.(*client)
+	if !ok {
+		return cc.NewStream(ctx, service, method, firstMsg)
+	}
+	return c.newStream(ctx, prefix, service, method, firstMsg)
+}
+
 // Invoke executes a unary RPC with the remote.
 func (c *client) Invoke(rctx context.Context, service, method string, in, out Message) error {
+	return c.invoke(rctx, nil, service, method, in, out)
+}
+
+// invoke executes a unary RPC with an optional pre-marshaled prefix.
+func (c *client) invoke(rctx context.Context, prefix CallStartPrefix, service, method string, in, out Message) error {
+	// the invoker fast path does not apply compression.
+	if c.invoker != nil && compressionFromContext(rctx) == CompressNone {
+		return c.invoker.Invoke(rctx, service, method, in, out)
+	}
+
 	ctx, ctxCancel := context.WithCancel(rctx)
 	defer ctxCancel()
 
@@ -47,6 +99,9 @@ func (c *client) Invoke(rctx context.Context, service, method string, in, out Me
 		return err
 	}
 	clientRPC := NewClientRPC(ctx, service, method)
+	clientRPC.setCallStartPrefix(prefix)
+	// unary: accumulate into a single buffer, drop unconsumed extras.
+	clientRPC.setUnary()
 	writer, err := c.openStream(ctx, clientRPC.HandlePacket, clientRPC.HandleStreamClose)
 	if err != nil {
 		return err
@@ -69,6 +124,11 @@ func (c *client) Invoke(rctx context.Context, service, method string, in, out Me
 // NewStream starts a streaming RPC with the remote & returns the stream.
 // firstMsg is optional.
 func (c *client) NewStream(ctx context.Context, service, method string, firstMsg Message) (Stream, error) {
+	return c.newStream(ctx, nil, service, method, firstMsg)
+}
+
+// newStream starts a streaming RPC with an optional pre-marshaled prefix.
+func (c *client) newStream(ctx context.Context, prefix CallStartPrefix, service, method string, firstMsg Message) (Stream, error) {
 	var firstMsgData []byte
 	if firstMsg != nil {
 		var err error
@@ -79,6 +139,7 @@ func (c *client) NewStream(ctx context.Context, service, method string, firstMsg
 	}
 
 	clientRPC := NewClientRPC(ctx, service, method)
+	clientRPC.setCallStartPrefix(prefix)
 	writer, err := c.openStream(ctx, clientRPC.HandlePacket, clientRPC.HandleStreamClose)
 	if err != nil {
 		return nil, err
@@ -87,7 +148,10 @@ func (c *client) NewStream(ctx context.Context, service, method string, firstMsg
 		return nil, err
 	}
 
-	return NewMsgStream(ctx, clientRPC.writer, clientRPC.dataCh), nil
+	strm := NewMsgStream(ctx, clientRPC.writer, clientRPC.dataQueue)
+	strm.setStats(clientRPC.stats)
+	strm.setCompression(clientRPC.compressCodec)
+	return strm, nil
 }
 
 // _ is a type assertion
@@ -1,10 +1,9 @@
 import { pipe } from 'it-pipe'
-import { pushable, Pushable } from 'it-pushable'
 
 import type { TsProtoRpc } from './ts-proto-rpc.js'
 import type { OpenStreamFunc } from './stream.js'
 import { ClientRPC } from './client-rpc.js'
-import { writeToPushable } from './pushable.js'
+import { BoundedPushable, writeToPushable } from './pushable.js'
 import {
   decodePacketSource,
   encodePacketSource,
@@ -18,9 +17,12 @@ export class Client implements TsProtoRpc {
   private openStreamFn: Promise<OpenStreamFunc>
   // _openStreamFn resolves openStreamFn.
   private _openStreamFn?: (conn?: OpenStreamFunc, err?: Error) => void
+  // highWaterMark bounds the rpc queues, throttling producers.
+  protected highWaterMark?: number
 
-  constructor(openStreamFn?: OpenStreamFunc) {
+  constructor(openStreamFn?: OpenStreamFunc, highWaterMark?: number) {
     this.openStreamFn = this.setOpenStreamFn(openStreamFn)
+    this.highWaterMark = highWaterMark
   }
 
   // setOpenStreamFn updates the openStreamFn for the Client.
@@ -96,12 +98,12 @@ export class Client implements TsProtoRpc {
     method: string,
     data: Uint8Array
   ): AsyncIterable<Uint8Array> {
-    const serverData: Pushable<Uint8Array> = pushable({ objectMode: true })
+    const serverData = new BoundedPushable<Uint8Array>(this.highWaterMark)
     this.startRpc(service, method, data)
       .then(async (call) => {
         return writeToPushable(call.rpcDataSource, serverData)
       })
-      .catch(serverData.throw.bind(serverData))
+      .catch((err) => serverData.end(err as Error))
     return serverData
   }
 
@@ -111,34 +113,35 @@ export class Client implements TsProtoRpc {
     method: string,
     data: AsyncIterable<Uint8Array>
   ): AsyncIterable<Uint8Array> {
-    const serverData: Pushable<Uint8Array> = pushable({ objectMode: true })
+    const serverData = new BoundedPushable<Uint8Array>(this.highWaterMark)
     this.startRpc(service, method, null)
       .then(async (call) => {
         call.writeCallDataFromSource(data)
         try {
           for await (const message of call.rpcDataSource) {
-            serverData.push(message)
+            await serverData.push(message)
           }
         } catch (err) {
-          serverData.throw(err as Error)
+          serverData.end(err as Error)
         }
         serverData.end()
       })
-      .catch(serverData.throw.bind(serverData))
+      .catch((err) => serverData.end(err as Error))
     return serverData
   }
 
   // startRpc is a common utility function to begin a rpc call.
   // throws any error starting the rpc call
   // if data == null and data.length == 0, sends a separate data packet.
-  private async startRpc(
+  // overridden by transports with their own packet framing, see PacketConn.
+  protected async startRpc(
     rpcService: string,
     rpcMethod: string,
     data: Uint8Array | null
   ): Promise<ClientRPC> {
     const openStreamFn = await this.openStreamFn
     const conn = await openStreamFn()
-    const call = new ClientRPC(rpcService, rpcMethod)
+    const call = new ClientRPC(rpcService, rpcMethod, this.highWaterMark)
     pipe(
       conn,
       parseLengthPrefixTransform(),
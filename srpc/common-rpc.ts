@@ -1,5 +1,7 @@
 import type { Sink } from 'it-stream-types'
-import { pushable } from 'it-pushable'
+import Long from 'long'
+
+import { BoundedPushable } from './pushable.js'
 
 import type { CallData, CallStart } from './rpcproto.pb.js'
 import { Packet } from './rpcproto.pb.js'
@@ -11,31 +13,30 @@ export class CommonRPC {
   // source is the packet source for outgoing Packets.
   public source: AsyncIterable<Packet>
   // _source is used to write to the source.
-  private readonly _source: {
-    push: (val: Packet) => void
-    end: (err?: Error) => void
-  }
+  // bounded: push resolves when the transport drains the queue.
+  private readonly _source: BoundedPushable<Packet>
   // rpcDataSource emits incoming client RPC messages to the caller.
   public readonly rpcDataSource: AsyncIterable<Uint8Array>
   // _rpcDataSource is used to write to the rpc message source.
-  private readonly _rpcDataSource: {
-    push: (val: Uint8Array) => void
-    end: (err?: Error) => void
-  }
+  // bounded: push resolves when the caller consumes the queue.
+  private readonly _rpcDataSource: BoundedPushable<Uint8Array>
 
   // service is the rpc service
   protected service?: string
   // method is the rpc method
   protected method?: string
+  // pendingData accumulates chunked message fragments until the final
+  // fragment arrives.
+  private pendingData: Uint8Array[] = []
 
-  constructor() {
+  constructor(highWaterMark?: number) {
     this.sink = this._createSink()
 
-    const sourcev = this._createSource()
+    const sourcev = new BoundedPushable<Packet>(highWaterMark)
     this.source = sourcev
     this._source = sourcev
 
-    const rpcDataSource = this._createRpcDataSource()
+    const rpcDataSource = new BoundedPushable<Uint8Array>(highWaterMark)
     this.rpcDataSource = rpcDataSource
     this._rpcDataSource = rpcDataSource
   }
@@ -51,30 +52,34 @@ export class CommonRPC {
       dataIsZero: !!data && data.length === 0,
       complete: complete || false,
       error: error || '',
+      dataContinued: false,
     }
     await this.writePacket({
       body: {
         $case: 'callData',
         callData,
       },
+      rpcId: Long.UZERO,
     })
   }
 
   // writeCallDataFromSource writes all call data from the iterable.
+  // awaits each write: the data source is throttled by transport drain.
   public async writeCallDataFromSource(dataSource: AsyncIterable<Uint8Array>) {
     try {
       for await (const data of dataSource) {
-        this.writeCallData(data)
+        await this.writeCallData(data)
       }
-      this.writeCallData(undefined, true)
+      await this.writeCallData(undefined, true)
     } catch (err) {
       this.close(err as Error)
     }
   }
 
   // writePacket writes a packet to the stream.
+  // resolves when the outgoing queue has capacity.
   protected async writePacket(packet: Packet) {
-    this._source.push(packet)
+    await this._source.push(packet)
   }
 
   // handleMessage handles an incoming encoded Packet.
@@ -96,6 +101,12 @@ export class CommonRPC {
         case 'callData':
           await this.handleCallData(packet.body.callData)
           break
+        case 'callCancel':
+          await this.handleCallCancel()
+          break
+        case 'keepAlive':
+          // liveness probe: consumed without routing to the rpc.
+          break
       }
     } catch (err) {
       let asError = err as Error
@@ -115,8 +126,15 @@ export class CommonRPC {
     )
   }
 
+  // handleCallCancel handles a CallCancel packet.
+  // the remote canceled the call: tear down the rpc.
+  public async handleCallCancel() {
+    this.close(new Error('rpc canceled by remote'))
+  }
+
   // pushRpcData pushes incoming rpc data to the rpc data source.
-  protected pushRpcData(
+  // resolves when the incoming queue has capacity.
+  protected async pushRpcData(
     data: Uint8Array | undefined,
     dataIsZero: boolean | undefined
   ) {
@@ -127,7 +145,7 @@ export class CommonRPC {
     } else if (!data || data.length === 0) {
       return
     }
-    this._rpcDataSource.push(data)
+    await this._rpcDataSource.push(data)
   }
 
   // handleCallData handles a CallData packet.
@@ -136,7 +154,32 @@ export class CommonRPC {
       throw new Error('call start must be sent before call data')
     }
 
-    this.pushRpcData(packet.data, packet.dataIsZero)
+    if (packet.dataContinued) {
+      // fragment of a chunked message: wait for the final fragment.
+      if (packet.data?.length) {
+        this.pendingData.push(packet.data)
+      }
+    } else if (this.pendingData.length) {
+      // final fragment: join the accumulated fragments.
+      const pending = this.pendingData
+      this.pendingData = []
+      if (packet.data?.length) {
+        pending.push(packet.data)
+      }
+      let size = 0
+      for (const part of pending) {
+        size += part.length
+      }
+      const joined = new Uint8Array(size)
+      let offset = 0
+      for (const part of pending) {
+        joined.set(part, offset)
+        offset += part.length
+      }
+      await this.pushRpcData(joined, packet.dataIsZero)
+    } else {
+      await this.pushRpcData(packet.data, packet.dataIsZero)
+    }
     if (packet.error) {
       this._rpcDataSource.end(new Error(packet.error))
     } else if (packet.complete) {
@@ -166,18 +209,4 @@ export class CommonRPC {
       this._rpcDataSource.end()
     }
   }
-
-  // _createSource returns a value for the source field.
-  private _createSource() {
-    return pushable<Packet>({
-      objectMode: true,
-    })
-  }
-
-  // _createRpcDataSource returns a value for the rpc data source field.
-  private _createRpcDataSource() {
-    return pushable<Uint8Array>({
-      objectMode: true,
-    })
-  }
 }
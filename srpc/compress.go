@@ -0,0 +1,139 @@
+package srpc
+
+import (
+	"bytes"
+	"compress/flate"
+	"context"
+	"io"
+	"sync"
+
+	"github.com/pkg/errors"
+)
+
+// compression type identifiers carried in the CallStart data_compress field.
+const (
+	// CompressNone indicates no compression is applied.
+	CompressNone uint32 = 0
+	// CompressDeflate indicates DEFLATE (RFC 1951) compression.
+	CompressDeflate uint32 = 1
+)
+
+// CompressionCodec compresses and decompresses rpc message data.
+//
+// implementations must be safe for concurrent use.
+type CompressionCodec interface {
+	// CompressionType returns the compression type identifier.
+	// sent in the CallStart data_compress field, must be non-zero.
+	CompressionType() uint32
+	// Compress compresses the data, returning a new buffer.
+	Compress(data []byte) ([]byte, error)
+	// Decompress decompresses the data, returning a new buffer.
+	Decompress(data []byte) ([]byte, error)
+}
+
+var (
+	// compressionCodecsMtx guards compressionCodecs.
+	compressionCodecsMtx sync.RWMutex
+	// compressionCodecs contains the registered compression codecs.
+	compressionCodecs = map[uint32]CompressionCodec{
+		CompressDeflate: deflateCodec{},
+	}
+)
+
+// RegisterCompressionCodec registers a compression codec.
+// overwrites any existing codec with the same compression type.
+func RegisterCompressionCodec(codec CompressionCodec) error {
+	if codec == nil {
+		return errors.New("compression codec cannot be nil")
+	}
+	compressionType := codec.CompressionType()
+	if compressionType == CompressNone {
+		return errors.New("compression type cannot be zero")
+	}
+	compressionCodecsMtx.Lock()
+	compressionCodecs[compressionType] = codec
+	compressionCodecsMtx.Unlock()
+	return nil
+}
+
+// getCompressionCodec looks up the codec for the compression type.
+// returns nil, nil if compressionType is CompressNone.
+// errors if the compression type is unknown.
+func getCompressionCodec(compressionType uint32) (CompressionCodec, error) {
+	if compressionType == CompressNone {
+		return nil, nil
+	}
+	compressionCodecsMtx.RLock()
+	codec := compressionCodecs[compressionType]
+	compressionCodecsMtx.RUnlock()
+	if codec == nil {
+		return nil, errors.Errorf("unsupported compression type %v", compressionType)
+	}
+	return codec, nil
+}
+
+// deflateCodec implements CompressionCodec with compress/flate.
+type deflateCodec struct{}
+
+// CompressionType returns the compression type identifier.
+func (deflateCodec) CompressionType() uint32 {
+	return CompressDeflate
+}
+
+// Compress compresses the data, returning a new buffer.
+func (deflateCodec) Compress(data []byte) ([]byte, error) {
+	var buf bytes.Buffer
+	fw, err := flate.NewWriter(&buf, flate.DefaultCompression)
+	if err != nil {
+		return nil, err
+	}
+	if _, err := fw.Write(data); err != nil {
+		return nil, err
+	}
+	if err := fw.Close(); err != nil {
+		return nil, err
+	}
+	return buf.Bytes(), nil
+}
+
+// Decompress decompresses the data, returning a new buffer.
+//
+// bounds the decompressed size at maxMessageSize: the frame length
+// prefix only caps the compressed size, so without the bound a small
+// frame could inflate to an arbitrarily large buffer.
+func (deflateCodec) Decompress(data []byte) ([]byte, error) {
+	fr := flate.NewReader(bytes.NewReader(data))
+	// read one byte past the limit to detect overflow.
+	out, err := io.ReadAll(io.LimitReader(fr, int64(maxMessageSize)+1))
+	if err != nil {
+		return nil, err
+	}
+	if len(out) > int(maxMessageSize) {
+		return nil, errors.Errorf("decompressed message size greater than maximum %v", maxMessageSize)
+	}
+	if err := fr.Close(); err != nil {
+		return nil, err
+	}
+	return out, nil
+}
+
+// compressionContextKey is the context key for the compression type.
+type compressionContextKey struct{}
+
+// WithCompression attaches a compression type to the context.
+//
+// client calls started with the returned context offer the compression
+// type in CallStart and apply it to all message data on the rpc.
+// the server must have a codec registered for the type.
+func WithCompression(ctx context.Context, compressionType uint32) context.Context {
+	return context.WithValue(ctx, compressionContextKey{}, compressionType)
+}
+
+// compressionFromContext returns the compression type from the context.
+func compressionFromContext(ctx context.Context) uint32 {
+	compressionType, _ := ctx.Value(compressionContextKey{}).(uint32)
+	return compressionType
+}
+
+// _ is a type assertion
+var _ CompressionCodec = deflateCodec{}
@@ -0,0 +1,169 @@
+import type { Duplex, Sink } from 'it-stream-types'
+import Long from 'long'
+
+import { Packet } from './rpcproto.pb.js'
+import { CommonRPC } from './common-rpc.js'
+import { ClientRPC } from './client-rpc.js'
+import { Client } from './client.js'
+import { BoundedPushable } from './pushable.js'
+import type { Server } from './server.js'
+
+// PacketConnParams are parameters that can be passed to PacketConn.
+export interface PacketConnParams {
+  // outbound indicates the local side initiated the connection.
+  // used to partition the rpc id space between the two sides.
+  // defaults to true.
+  outbound?: boolean
+  // highWaterMark bounds the outgoing packet queue and the rpc queues,
+  // throttling producers until the transport drains.
+  highWaterMark?: number
+}
+
+// PacketConn multiplexes RPCs over a packet-framed connection by rpc id.
+//
+// each connection message is exactly one encoded Packet: the transport
+// provides the message framing (e.g. WebSocket binary messages), so no
+// stream muxer or length prefix is needed. counterpart to the Go
+// PacketMux.
+//
+// Implements the client by stamping outgoing packets with a fresh rpc id.
+// Implements the server by routing incoming call starts to the Server.
+// If the server is unset, rejects any incoming calls.
+export class PacketConn implements Duplex<Uint8Array> {
+  // source is the outgoing encoded packet source.
+  // bounded: pushes resolve when the transport drains the queue.
+  public readonly source: BoundedPushable<Uint8Array>
+  // sink is the incoming encoded packet sink.
+  public readonly sink: Sink<Uint8Array>
+  // server is the server side, if set.
+  private server?: Server
+  // rpcs contains the set of active rpcs by id.
+  private rpcs: Map<string, CommonRPC> = new Map()
+  // nextRpcId is the next outbound rpc id.
+  // outbound uses odd ids, inbound uses even.
+  private nextRpcId: Long
+  // highWaterMark bounds the rpc queues, throttling producers.
+  private highWaterMark?: number
+
+  constructor(server?: Server, packetConnParams?: PacketConnParams) {
+    if (server) {
+      this.server = server
+    }
+    const outbound = packetConnParams?.outbound ?? true
+    this.nextRpcId = Long.fromNumber(outbound ? 1 : 2, true)
+    this.highWaterMark = packetConnParams?.highWaterMark
+    this.source = new BoundedPushable(this.highWaterMark)
+    this.sink = this._createSink()
+  }
+
+  // buildClient builds a new client from the connection.
+  public buildClient(): Client {
+    return new PacketConnClient(this)
+  }
+
+  // startRpc starts an outgoing client RPC over the connection.
+  public startRpc(service: string, method: string): ClientRPC {
+    const rpc = new ClientRPC(service, method, this.highWaterMark)
+    const rpcId = this.nextRpcId
+    this.nextRpcId = this.nextRpcId.add(2)
+    this.registerRpc(rpcId, rpc)
+    return rpc
+  }
+
+  // registerRpc registers the rpc & pumps its outgoing packets.
+  private registerRpc(rpcId: Long, rpc: CommonRPC) {
+    const key = rpcId.toString()
+    this.rpcs.set(key, rpc)
+    this.pumpRpc(rpcId, rpc)
+      .catch(() => {
+        // the rpc source ended with an error (cancel or conn teardown):
+        // the error is local to the rpc, which has already observed it.
+      })
+      .finally(() => {
+        this.rpcs.delete(key)
+      })
+  }
+
+  // pumpRpc copies packets from the rpc to the connection.
+  // stamps the rpc id on each outgoing packet.
+  // awaits each push: rpcs are throttled by transport drain.
+  private async pumpRpc(rpcId: Long, rpc: CommonRPC) {
+    for await (const packet of rpc.source) {
+      if (this.source.isEnded) {
+        // the connection closed under the rpc: drop the packet.
+        break
+      }
+      packet.rpcId = rpcId
+      await this.source.push(Packet.encode(packet).finish())
+    }
+  }
+
+  // handleMessage handles an incoming encoded Packet.
+  private async handleMessage(message: Uint8Array) {
+    const packet = Packet.decode(message)
+    const key = packet.rpcId.toString()
+    let rpc = this.rpcs.get(key)
+    if (!rpc) {
+      if (packet.body?.$case !== 'callStart') {
+        // late packet for a completed rpc: drop it.
+        return
+      }
+      const server = this.server
+      if (!server) {
+        throw new Error('unexpected call start: server not implemented')
+      }
+      // incoming call: construct the server rpc & register it.
+      rpc = server.startRpc()
+      this.registerRpc(packet.rpcId, rpc)
+    }
+    try {
+      await rpc.handlePacket(packet)
+    } catch (_err) {
+      // handlePacket closes the rpc: the error is local to the rpc.
+      this.rpcs.delete(key)
+    }
+  }
+
+  // _createSink returns a value for the sink field.
+  private _createSink(): Sink<Uint8Array> {
+    return async (source) => {
+      let err: Error | undefined
+      try {
+        for await (const message of source) {
+          await this.handleMessage(message)
+        }
+      } catch (sinkErr) {
+        err = sinkErr as Error
+      }
+      // the connection closed: close all ongoing rpcs.
+      const rpcs = this.rpcs
+      this.rpcs = new Map()
+      for (const rpc of rpcs.values()) {
+        rpc.close(err)
+      }
+      this.source.end(err)
+    }
+  }
+}
+
+// PacketConnClient implements the Client over a PacketConn.
+export class PacketConnClient extends Client {
+  // conn is the packet conn.
+  private conn: PacketConn
+
+  constructor(conn: PacketConn) {
+    super()
+    this.conn = conn
+  }
+
+  // startRpc starts an rpc multiplexed over the packet conn.
+  protected override async startRpc(
+    rpcService: string,
+    rpcMethod: string,
+    data: Uint8Array | null
+  ): Promise<ClientRPC> {
+    const call = this.conn.startRpc(rpcService, rpcMethod)
+    await call.writeCallStart(data || undefined)
+    return call
+  }
+}
@@ -17,4 +17,15 @@ var (
 	ErrEmptyMethodID = errors.New("method id empty")
 	// ErrEmptyServiceID is returned if the service id was empty.
 	ErrEmptyServiceID = errors.New("service id empty")
+	// ErrResponseTooLarge is returned when a rpc response exceeds the
+	// configured size limit, see WithMaxResponseSize.
+	ErrResponseTooLarge = errors.New("response size limit exceeded")
+	// ErrKeepAliveTimeout is returned when the remote missed the keep-alive deadline.
+	ErrKeepAliveTimeout = errors.New("keep-alive timeout")
+	// ErrServerOverloaded is returned when a stream is rejected because
+	// an admission limit was reached, see NewServerWithLimits.
+	ErrServerOverloaded = errors.New("server overloaded")
+	// ErrRecvWindowStalled is returned when an rpc fails because its
+	// receive window stayed full for too long, see SetReceiveWindow.
+	ErrRecvWindowStalled = errors.New("receive window stalled")
 )
@@ -1,5 +1,7 @@
 package srpc
 
+import "context"
+
 // Handler describes a SRPC call handler implementation.
 type Handler interface {
 	// GetServiceID returns the ID of the service.
@@ -11,3 +13,16 @@ type Handler interface {
 	// If service string is empty, ignore it.
 	InvokeMethod(serviceID, methodID string, strm Stream) (bool, error)
 }
+
+// UnaryMethodHandler is a Handler with an inline fast path for unary methods.
+//
+// emitted by protoc-gen-go-starpc for services with unary methods: the
+// request bytes are decoded and the method invoked as a plain function
+// call, without the goroutine and message stream machinery.
+type UnaryMethodHandler interface {
+	Handler
+	// InvokeUnaryMethod invokes a unary method with the request data.
+	// Returns handled=false if the method is not unary or not found.
+	// If service string is empty, ignore it.
+	InvokeUnaryMethod(ctx context.Context, serviceID, methodID string, reqData []byte) (Message, bool, error)
+}
@@ -2,8 +2,19 @@ export type { PacketHandler, Stream, OpenStreamFunc } from './stream.js'
 export { Client } from './client.js'
 export { Server } from './server.js'
 export { Conn, ConnParams } from './conn.js'
+export {
+  PacketConn,
+  PacketConnClient,
+  PacketConnParams,
+} from './conn-packet.js'
 export { Handler, InvokeFn, createHandler, createInvokeFn } from './handler.js'
-export { Packet, CallStart, CallData } from './rpcproto.pb.js'
+export {
+  Packet,
+  CallStart,
+  CallData,
+  CallCancel,
+  KeepAlive,
+} from './rpcproto.pb.js'
 export { Mux, StaticMux, createMux } from './mux.js'
 export {
   BroadcastChannelDuplex,
@@ -14,5 +25,6 @@ export {
   MessagePortIterable,
   newMessagePortIterable,
   MessagePortConn,
+  MessagePortConnParams,
 } from './message-port.js'
-export { writeToPushable } from './pushable'
+export { BoundedPushable, writeToPushable } from './pushable'
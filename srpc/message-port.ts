@@ -5,6 +5,24 @@ import { ConnParams } from './conn.js'
 import { DuplexConn } from './conn-duplex.js'
 import { Server } from './server'
 
+// transferList returns the transfer list for an outgoing message.
+//
+// transfers the underlying ArrayBuffer when the message is a binary view
+// covering its entire buffer. partial views may alias a larger pooled
+// buffer and SharedArrayBuffers cannot be transferred: those messages
+// fall back to the structured clone.
+function transferList(msg: unknown): Transferable[] | undefined {
+  if (
+    ArrayBuffer.isView(msg) &&
+    msg.byteOffset === 0 &&
+    msg.buffer instanceof ArrayBuffer &&
+    msg.byteLength === msg.buffer.byteLength
+  ) {
+    return [msg.buffer]
+  }
+  return undefined
+}
+
 // MessagePortIterable is a AsyncIterable wrapper for MessagePort.
 export class MessagePortIterable<T> implements Duplex<T> {
   // port is the message port
@@ -15,9 +33,12 @@ export class MessagePortIterable<T> implements Duplex<T> {
   public source: AsyncIterable<T>
   // _source is the EventIterator for source.
   private _source: EventIterator<T>
+  // transfer indicates outgoing buffers are posted as transferables.
+  private transfer: boolean
 
-  constructor(port: MessagePort) {
+  constructor(port: MessagePort, transfer?: boolean) {
     this.port = port
+    this.transfer = transfer || false
     this.sink = this._createSink()
     this._source = this._createSource()
     this.source = this._source
@@ -32,7 +53,14 @@ export class MessagePortIterable<T> implements Duplex<T> {
   private _createSink(): Sink<T> {
     return async (source) => {
       for await (const msg of source) {
-        this.port.postMessage(msg)
+        if (this.transfer) {
+          // zero-copy path: move the buffer to the remote thread.
+          // ownership contract: the sender must not touch the message
+          // after posting it, the buffer is detached on this side.
+          this.port.postMessage(msg, transferList(msg) ?? [])
+        } else {
+          this.port.postMessage(msg)
+        }
       }
     }
   }
@@ -56,9 +84,21 @@ export class MessagePortIterable<T> implements Duplex<T> {
 
 // newMessagePortIterable constructs a MessagePortIterable with a channel name.
 export function newMessagePortIterable<T>(
-  port: MessagePort
+  port: MessagePort,
+  transfer?: boolean
 ): MessagePortIterable<T> {
-  return new MessagePortIterable<T>(port)
+  return new MessagePortIterable<T>(port, transfer)
+}
+
+// MessagePortConnParams are parameters that can be passed to MessagePortConn.
+export interface MessagePortConnParams extends ConnParams {
+  // transfer posts outgoing buffers as transferables when possible,
+  // moving them to the remote thread instead of structured cloning.
+  //
+  // ownership contract: callers must not reuse a message buffer after
+  // writing it to the connection, the buffer is detached when posted.
+  // buffers which are partial views or shared are cloned as before.
+  transfer?: boolean
 }
 
 // MessagePortConn implements a connection with a MessagePort.
@@ -68,8 +108,15 @@ export class MessagePortConn extends DuplexConn {
   // messagePort is the message port iterable.
   private messagePort: MessagePortIterable<Uint8Array>
 
-  constructor(port: MessagePort, server?: Server, connParams?: ConnParams) {
-    const messagePort = new MessagePortIterable<Uint8Array>(port)
+  constructor(
+    port: MessagePort,
+    server?: Server,
+    connParams?: MessagePortConnParams
+  ) {
+    const messagePort = new MessagePortIterable<Uint8Array>(
+      port,
+      connParams?.transfer
+    )
     super(messagePort, server, connParams)
     this.messagePort = messagePort
   }
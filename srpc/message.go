@@ -5,3 +5,13 @@ type Message interface {
 	MarshalVT() ([]byte, error)
 	UnmarshalVT([]byte) error
 }
+
+// UnsafeUnmarshaler is a Message that supports zero-copy unmarshal.
+//
+// UnmarshalVTUnsafe aliases bytes and string fields into the source
+// buffer instead of copying them out. generated by vtprotobuf with the
+// unsafe feature enabled. see MsgStream.EnableMsgRecvZeroCopy for the
+// buffer-lifetime contract.
+type UnsafeUnmarshaler interface {
+	UnmarshalVTUnsafe([]byte) error
+}
@@ -1,30 +1,93 @@
 package srpc
 
 import (
+	"bytes"
 	"context"
 	"io"
 )
 
+// dataChunkSize is the maximum CallData payload size in bytes before a
+// message is split into chunked fragments. 0 disables chunked sends.
+var dataChunkSize = 0
+
+// SetDataChunkSize enables splitting outgoing messages larger than size
+// bytes into multiple CallData packets flagged with data_continued.
+//
+// chunked sends are disabled by default (size 0): the remote must
+// support chunked framing to reassemble the fragments. bounds the size
+// of any single transport frame regardless of message size.
+func SetDataChunkSize(size int) {
+	dataChunkSize = size
+}
+
 // MsgStream implements the stream interface passed to implementations.
 type MsgStream struct {
 	// ctx is the stream context
 	ctx context.Context
 	// writer is the stream writer
 	writer Writer
-	// dataCh is the incoming data channel.
-	dataCh chan []byte
+	// dataQueue is the incoming data queue.
+	dataQueue *recvQueue
+	// stats tracks rpc events, nil if no stats handler is registered.
+	stats *rpcStats
+	// codec compresses message data, nil if compression is disabled.
+	codec CompressionCodec
+	// recvZeroCopy enables zero-copy unmarshal of received messages.
+	recvZeroCopy bool
+	// sentClose indicates a completion packet was written.
+	// checked by the server rpc to skip a duplicate completion write.
+	sentClose bool
 }
 
 // NewMsgStream constructs a new Stream with a ClientRPC.
-// dataCh should be closed when no more messages will arrive.
-func NewMsgStream(ctx context.Context, writer Writer, dataCh chan []byte) *MsgStream {
+// dataQueue should be closed when no more messages will arrive.
+func NewMsgStream(ctx context.Context, writer Writer, dataQueue *recvQueue) *MsgStream {
 	return &MsgStream{
-		ctx:    ctx,
-		writer: writer,
-		dataCh: dataCh,
+		ctx:       ctx,
+		writer:    writer,
+		dataQueue: dataQueue,
 	}
 }
 
+// setStats sets the rpc stats tracker for outgoing messages.
+func (r *MsgStream) setStats(stats *rpcStats) {
+	r.stats = stats
+}
+
+// setCompression sets the compression codec for message data.
+func (r *MsgStream) setCompression(codec CompressionCodec) {
+	r.codec = codec
+}
+
+// EnableMsgRecvZeroCopy enables zero-copy receive on the stream.
+//
+// MsgRecv will use UnmarshalVTUnsafe when the message supports it,
+// aliasing bytes and string fields into the received frame buffer
+// instead of copying them out. this skips the final copy for
+// blob-heavy messages.
+//
+// buffer-lifetime contract: the aliased fields remain valid for as
+// long as the caller retains the message. the caller must not mutate
+// aliased bytes fields and must copy any field it mutates or hands to
+// code that does. messages that do not implement UnsafeUnmarshaler
+// fall back to the copying UnmarshalVT.
+func (r *MsgStream) EnableMsgRecvZeroCopy() {
+	r.recvZeroCopy = true
+}
+
+// EnableStreamZeroCopy enables zero-copy receive on the stream if the
+// underlying stream supports it, returning whether it was enabled.
+//
+// works with the typed stream wrappers emitted by protoc-gen-go-starpc:
+// they embed the srpc.Stream and promote its methods.
+func EnableStreamZeroCopy(strm Stream) bool {
+	zc, ok := strm.(interface{ EnableMsgRecvZeroCopy() })
+	if ok {
+		zc.EnableMsgRecvZeroCopy()
+	}
+	return ok
+}
+
 // Context is canceled when the Stream is no longer valid.
 func (r *MsgStream) Context() context.Context {
 	return r.ctx
@@ -42,28 +105,196 @@ func (r *MsgStream) MsgSend(msg Message) error {
 	if err != nil {
 		return err
 	}
+	if r.codec != nil && len(msgData) != 0 {
+		if msgData, err = r.codec.Compress(msgData); err != nil {
+			return err
+		}
+	}
+	if chunkSize := dataChunkSize; chunkSize > 0 && len(msgData) > chunkSize {
+		if err := r.sendChunked(msgData, chunkSize); err != nil {
+			return err
+		}
+		r.stats.sentMsg(len(msgData))
+		return nil
+	}
 	outPkt := NewCallDataPacket(msgData, len(msgData) == 0, false, nil)
-	return r.writer.WritePacket(outPkt)
+	if err := r.writer.WritePacketPooled(outPkt); err != nil {
+		return err
+	}
+	r.stats.sentMsg(len(msgData))
+	return nil
+}
+
+// sendChunked sends msgData split into chunkSize fragments.
+// all fragments except the last are flagged with data_continued.
+// the fragments coalesce into a single transport write, see WritePackets.
+func (r *MsgStream) sendChunked(msgData []byte, chunkSize int) error {
+	nchunks := (len(msgData) + chunkSize - 1) / chunkSize
+	pkts := make([]*Packet, 0, nchunks)
+	for offset := 0; offset < len(msgData); offset += chunkSize {
+		end := offset + chunkSize
+		if end < len(msgData) {
+			pkts = append(pkts, NewCallDataContinuedPacket(msgData[offset:end]))
+		} else {
+			pkts = append(pkts, NewCallDataPacket(msgData[offset:], false, false, nil))
+		}
+	}
+	return r.writer.WritePackets(pkts)
+}
+
+// MsgSendAndClose sends the message and closes the send direction of
+// the stream with a single transport write.
+//
+// equivalent to MsgSend followed by CloseSend, without the second
+// write: the data and completion flag ride in one packet.
+func (r *MsgStream) MsgSendAndClose(msg Message) error {
+	select {
+	case <-r.ctx.Done():
+		return context.Canceled
+	default:
+	}
+
+	msgData, err := msg.MarshalVT()
+	if err != nil {
+		return err
+	}
+	if r.codec != nil && len(msgData) != 0 {
+		if msgData, err = r.codec.Compress(msgData); err != nil {
+			return err
+		}
+	}
+	outPkt := NewCallDataPacket(msgData, len(msgData) == 0, true, nil)
+	if err := r.writer.WritePacketPooled(outPkt); err != nil {
+		return err
+	}
+	r.sentClose = true
+	r.stats.sentMsg(len(msgData))
+	return nil
+}
+
+// MsgSendAndClose sends the final message & the completion flag in one
+// write when the stream supports it, otherwise MsgSend then CloseSend.
+//
+// used by generated handlers to coalesce the final data+close sequence.
+func MsgSendAndClose(strm Stream, msg Message) error {
+	if ms, ok := strm.(interface{ MsgSendAndClose(Message) error }); ok {
+		return ms.MsgSendAndClose(msg)
+	}
+	if err := strm.MsgSend(msg); err != nil {
+		return err
+	}
+	return strm.CloseSend()
 }
 
 // MsgRecv receives an incoming message from the remote.
 // Parses the message into the object at msg.
 func (r *MsgStream) MsgRecv(msg Message) error {
-	select {
-	case <-r.Context().Done():
-		return context.Canceled
-	case data, ok := <-r.dataCh:
+	data, ok, err := r.dataQueue.popFull(r.ctx)
+	if err != nil {
+		return err
+	}
+	if !ok {
+		return io.EOF
+	}
+	if r.codec != nil && len(data) != 0 {
+		if data, err = r.codec.Decompress(data); err != nil {
+			return err
+		}
+	}
+	if r.recvZeroCopy {
+		if unsafeMsg, ok := msg.(UnsafeUnmarshaler); ok {
+			return unsafeMsg.UnmarshalVTUnsafe(data)
+		}
+	}
+	return msg.UnmarshalVT(data)
+}
+
+// RecvReader returns an io.Reader over the raw data of the next
+// logical message, yielding chunked fragments as they arrive without
+// joining them into a single buffer.
+func (r *MsgStream) RecvReader() io.Reader {
+	if r.codec != nil {
+		// compressed fragments cannot be streamed individually:
+		// join & decompress the full message instead.
+		return &msgDecompressReader{strm: r}
+	}
+	return &msgChunkReader{strm: r}
+}
+
+// msgDecompressReader reads the next logical message decompressed.
+type msgDecompressReader struct {
+	// strm is the message stream
+	strm *MsgStream
+	// rd reads the decompressed message data.
+	rd *bytes.Reader
+}
+
+// Read pops & decompresses the next message on first use.
+func (c *msgDecompressReader) Read(p []byte) (int, error) {
+	if c.rd == nil {
+		data, ok, err := c.strm.dataQueue.popFull(c.strm.ctx)
+		if err != nil {
+			return 0, err
+		}
 		if !ok {
-			return io.EOF
+			return 0, io.EOF
+		}
+		if len(data) != 0 {
+			if data, err = c.strm.codec.Decompress(data); err != nil {
+				return 0, err
+			}
 		}
-		return msg.UnmarshalVT(data)
+		c.rd = bytes.NewReader(data)
 	}
+	return c.rd.Read(p)
+}
+
+// msgChunkReader reads the fragments of one logical message.
+type msgChunkReader struct {
+	// strm is the message stream
+	strm *MsgStream
+	// buf is the remainder of the current fragment.
+	buf []byte
+	// started indicates at least one fragment was consumed.
+	started bool
+	// done indicates the final fragment was consumed.
+	done bool
+}
+
+// Read reads data from the current fragment, popping the next as needed.
+func (c *msgChunkReader) Read(p []byte) (int, error) {
+	for len(c.buf) == 0 {
+		if c.done {
+			return 0, io.EOF
+		}
+		msg, ok, err := c.strm.dataQueue.pop(c.strm.ctx)
+		if err != nil {
+			return 0, err
+		}
+		if !ok {
+			if c.started {
+				// the queue closed mid-message
+				return 0, io.ErrUnexpectedEOF
+			}
+			return 0, io.EOF
+		}
+		c.started = true
+		c.buf = msg.data
+		c.done = !msg.continued
+	}
+	n := copy(p, c.buf)
+	c.buf = c.buf[n:]
+	return n, nil
 }
 
 // CloseSend signals to the remote that we will no longer send any messages.
 func (r *MsgStream) CloseSend() error {
 	outPkt := NewCallDataPacket(nil, false, true, nil)
-	return r.writer.WritePacket(outPkt)
+	if err := r.writer.WritePacket(outPkt); err != nil {
+		return err
+	}
+	r.sentClose = true
+	return nil
 }
 
 // Close closes the stream.
@@ -0,0 +1,109 @@
+package srpc
+
+import (
+	"context"
+
+	"github.com/pkg/errors"
+)
+
+// frozenMux is an immutable Mux.
+//
+// the dispatch table is built once at construction and accessed with
+// zero synchronization, removing the RWMutex the default mux acquires
+// on every call start.
+type frozenMux struct {
+	// services contains a mapping from services to handlers.
+	services map[string]muxMethods
+}
+
+// NewFrozenMux builds an immutable Mux from the given handlers.
+//
+// intended for services which register once at boot and never change:
+// InvokeMethod performs two lock-free map lookups with no allocations.
+// Register always returns an error on a frozen mux.
+func NewFrozenMux(handlers ...Handler) (Mux, error) {
+	services := make(map[string]muxMethods, len(handlers))
+	for _, handler := range handlers {
+		serviceID := handler.GetServiceID()
+		if serviceID == "" {
+			return nil, ErrEmptyServiceID
+		}
+		serviceMethods := services[serviceID]
+		if serviceMethods == nil {
+			serviceMethods = make(muxMethods)
+			services[serviceID] = serviceMethods
+		}
+		for _, methodID := range handler.GetMethodIDs() {
+			if methodID != "" {
+				serviceMethods[methodID] = handler
+			}
+		}
+	}
+	return &frozenMux{services: services}, nil
+}
+
+// FreezeMux returns an immutable snapshot of a mux created with NewMux.
+//
+// returns the mux unchanged if it is not the default implementation.
+// handlers registered on the original mux after freezing are not
+// visible to the snapshot.
+func FreezeMux(m Mux) Mux {
+	dm, ok := m.(*mux)
+	if !ok {
+		return m
+	}
+	dm.rmtx.RLock()
+	defer dm.rmtx.RUnlock()
+	services := make(map[string]muxMethods, len(dm.services))
+	for serviceID, methods := range dm.services {
+		serviceMethods := make(muxMethods, len(methods))
+		for methodID, handler := range methods {
+			serviceMethods[methodID] = handler
+		}
+		services[serviceID] = serviceMethods
+	}
+	return &frozenMux{services: services}
+}
+
+// Register registers a new RPC method handler (service).
+// the frozen mux is immutable: Register always returns an error.
+func (m *frozenMux) Register(handler Handler) error {
+	return errors.New("cannot register a handler on a frozen mux")
+}
+
+// InvokeMethod invokes the method matching the service & method ID.
+// Returns false, nil if not found.
+// If service string is empty, ignore it.
+func (m *frozenMux) InvokeMethod(serviceID, methodID string, strm Stream) (bool, error) {
+	var handler Handler
+	if svcMethods := m.services[serviceID]; svcMethods != nil {
+		handler = svcMethods[methodID]
+	}
+	if handler == nil {
+		return false, nil
+	}
+
+	return handler.InvokeMethod(serviceID, methodID, strm)
+}
+
+// InvokeUnaryMethod invokes a unary method with the request data.
+// Returns handled=false if no unary fast path is available.
+func (m *frozenMux) InvokeUnaryMethod(ctx context.Context, serviceID, methodID string, reqData []byte) (Message, bool, error) {
+	var handler Handler
+	if svcMethods := m.services[serviceID]; svcMethods != nil {
+		handler = svcMethods[methodID]
+	}
+
+	uh, ok := handler.(UnaryMethodHandler)
+	if !ok {
+		return nil, false, nil
+	}
+
+	return uh.InvokeUnaryMethod(ctx, serviceID, methodID, reqData)
+}
+
+// _ is a type assertion
+var _ Mux = ((*frozenMux)(nil))
+
+// _ is a type assertion
+var _ UnaryInvoker = ((*frozenMux)(nil))
@@ -1,6 +1,20 @@
 package srpc
 
-import "sync"
+import (
+	"context"
+	"sync"
+)
+
+// UnaryInvoker is a Mux capable of invoking unary methods inline.
+//
+// implemented by the built-in mux implementations: ServerRPC uses it to
+// dispatch a unary call as a function call when the full request
+// arrived with the call start packet.
+type UnaryInvoker interface {
+	// InvokeUnaryMethod invokes a unary method with the request data.
+	// Returns handled=false if no unary fast path is available.
+	InvokeUnaryMethod(ctx context.Context, serviceID, methodID string, reqData []byte) (Message, bool, error)
+}
 
 // Mux contains a set of <service, method> handlers.
 type Mux interface {
@@ -72,5 +86,27 @@ func (m *mux) InvokeMethod(serviceID, methodID string, strm Stream) (bool, error
 	return handler.InvokeMethod(serviceID, methodID, strm)
 }
 
+// InvokeUnaryMethod invokes a unary method with the request data.
+// Returns handled=false if no unary fast path is available.
+func (m *mux) InvokeUnaryMethod(ctx context.Context, serviceID, methodID string, reqData []byte) (Message, bool, error) {
+	var handler Handler
+	m.rmtx.RLock()
+	svcMethods := m.services[serviceID]
+	if svcMethods != nil {
+		handler = svcMethods[methodID]
+	}
+	m.rmtx.RUnlock()
+
+	uh, ok := handler.(UnaryMethodHandler)
+	if !ok {
+		return nil, false, nil
+	}
+
+	return uh.InvokeUnaryMethod(ctx, serviceID, methodID, reqData)
+}
+
 // _ is a type assertion
 var _ Mux = ((*mux)(nil))
+
+// _ is a type assertion
+var _ UnaryInvoker = ((*mux)(nil))
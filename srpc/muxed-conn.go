@@ -8,8 +8,47 @@ import (
 	"github.com/libp2p/go-libp2p-core/network"
 	mplex "github.com/libp2p/go-libp2p/p2p/muxer/mplex"
 	mp "github.com/libp2p/go-mplex"
+	"github.com/pkg/errors"
 )
 
+// MuxerType identifies a stream muxer on the wire.
+type MuxerType uint8
+
+const (
+	// MuxerTypeMplex is the libp2p mplex muxer.
+	// mplex has no per-stream flow control.
+	MuxerTypeMplex MuxerType = 1
+	// MuxerTypeYamux is the yamux muxer.
+	// yamux has per-stream flow control: a slow stream backpressures
+	// only itself rather than the whole connection.
+	MuxerTypeYamux MuxerType = 2
+)
+
+// MuxerFactory constructs a MuxedConn over a ReadWriteCloser.
+// mirrors the muxerFactory parameter exposed by ConnParams in TypeScript.
+type MuxerFactory func(conn io.ReadWriteCloser, outbound bool) (network.MuxedConn, error)
+
+// GetMuxerFactory returns the MuxerFactory for the muxer type.
+func GetMuxerFactory(muxerType MuxerType) (MuxerFactory, error) {
+	switch muxerType {
+	case MuxerTypeMplex:
+		return NewMuxedConn, nil
+	case MuxerTypeYamux:
+		return NewYamuxMuxedConn, nil
+	default:
+		return nil, errors.Errorf("unknown muxer type %v", muxerType)
+	}
+}
+
+// NewMuxedConnWithType constructs a MuxedConn with the given muxer type.
+func NewMuxedConnWithType(conn io.ReadWriteCloser, outbound bool, muxerType MuxerType) (network.MuxedConn, error) {
+	factory, err := GetMuxerFactory(muxerType)
+	if err != nil {
+		return nil, err
+	}
+	return factory(conn, outbound)
+}
+
 // NewMuxedConn constructs a new MuxedConn from a ReadWriteCloser.
 func NewMuxedConn(conn io.ReadWriteCloser, outbound bool) (network.MuxedConn, error) {
 	m, err := mp.NewMultiplex(conn, outbound, nil)
@@ -30,6 +69,26 @@ func NewClientWithConn(conn net.Conn, outbound bool) (Client, error) {
 	return NewClientWithMuxedConn(mconn), nil
 }
 
+// NewClientWithNegotiatedMuxer writes the muxer type to the conn and
+// constructs the muxer and the client.
+//
+// counterpart to AcceptMuxedListenerNegotiate: the single leading byte
+// tells the server which muxer to use for the connection.
+func NewClientWithNegotiatedMuxer(conn net.Conn, muxerType MuxerType) (Client, error) {
+	factory, err := GetMuxerFactory(muxerType)
+	if err != nil {
+		return nil, err
+	}
+	if _, err := conn.Write([]byte{byte(muxerType)}); err != nil {
+		return nil, err
+	}
+	mconn, err := factory(conn, true)
+	if err != nil {
+		return nil, err
+	}
+	return NewClientWithMuxedConn(mconn), nil
+}
+
 // NewClientWithMuxedConn constructs a new client with a MuxedConn.
 func NewClientWithMuxedConn(conn network.MuxedConn) Client {
 	openStreamFn := NewOpenStreamWithMuxedConn(conn)
@@ -0,0 +1,466 @@
+package srpc
+
+import (
+	"context"
+	"io"
+	"sync"
+	"time"
+
+	"github.com/pkg/errors"
+)
+
+// PacketMux multiplexes RPCs over a single packet stream by rpc id.
+//
+// Replaces the per-RPC stream muxer setup: many concurrent RPCs share
+// one PacketReaderWriter over a single transport stream. Outgoing
+// packets are stamped with the rpc id, incoming packets are routed to
+// the handler registered for their id.
+//
+// A single read loop goroutine serves the entire connection.
+type PacketMux struct {
+	// ctx is the connection context
+	ctx context.Context
+	// prw is the underlying packet stream
+	prw PacketStream
+	// server handles incoming call-start packets, if set.
+	server *Server
+
+	// writeMtx guards writing to prw
+	writeMtx sync.Mutex
+
+	// mtx guards below fields
+	mtx sync.Mutex
+	// rpcs contains the set of active rpcs by id.
+	rpcs map[uint64]*packetMuxRPC
+	// nextID is the next outbound rpc id.
+	nextID uint64
+	// closed indicates the mux has closed.
+	closed bool
+	// closedErr is the error the mux closed with, if any.
+	closedErr error
+	// doneCh is closed when the mux closes.
+	doneCh chan struct{}
+	// serverRPCs counts in-flight incoming rpcs on this connection.
+	// used by the admission limits, see NewServerWithLimits.
+	serverRPCs int
+}
+
+// packetMuxRPC is the routing entry for one multiplexed RPC.
+type packetMuxRPC struct {
+	// handler handles incoming packets for the rpc.
+	handler PacketHandler
+	// closeHandler handles the rpc closing.
+	closeHandler CloseHandler
+	// client indicates this is the initiating side of the rpc.
+	client bool
+	// server indicates an incoming rpc holding an admission slot.
+	server bool
+}
+
+// NewPacketMux constructs a packet mux over a single byte stream using
+// length-prefixed packet framing.
+//
+// outbound indicates the local side initiated the transport stream,
+// used to partition the rpc id space between the two sides.
+// srv is optional: if set, incoming calls are handled with the server.
+// starts the read loop in a goroutine.
+func NewPacketMux(ctx context.Context, rwc io.ReadWriteCloser, outbound bool, srv *Server) *PacketMux {
+	return NewPacketMuxWithStream(ctx, NewPacketReadWriter(rwc), outbound, srv)
+}
+
+// NewPacketMuxWithStream constructs a packet mux over a packet stream.
+//
+// used with transports which provide their own packet framing, see
+// NewWebSocketPacketStream.
+func NewPacketMuxWithStream(ctx context.Context, prw PacketStream, outbound bool, srv *Server) *PacketMux {
+	m := &PacketMux{
+		ctx:    ctx,
+		prw:    prw,
+		server: srv,
+		rpcs:   make(map[uint64]*packetMuxRPC),
+		doneCh: make(chan struct{}),
+	}
+	// outbound uses odd ids, inbound uses even.
+	if outbound {
+		m.nextID = 1
+	} else {
+		m.nextID = 2
+	}
+	go m.prw.ReadPump(m.handlePacket, m.handleClose)
+	return m
+}
+
+// OpenStream opens a virtual stream multiplexed over the packet stream.
+// implements OpenStreamFunc.
+func (m *PacketMux) OpenStream(ctx context.Context, msgHandler PacketHandler, closeHandler CloseHandler) (Writer, error) {
+	select {
+	case <-ctx.Done():
+		return nil, context.Canceled
+	default:
+	}
+
+	m.mtx.Lock()
+	if m.closed {
+		err := m.closedErr
+		m.mtx.Unlock()
+		if err == nil {
+			err = io.EOF
+		}
+		return nil, err
+	}
+	id := m.nextID
+	m.nextID += 2
+	m.rpcs[id] = &packetMuxRPC{
+		handler:      msgHandler,
+		closeHandler: closeHandler,
+		client:       true,
+	}
+	m.mtx.Unlock()
+
+	return &packetMuxWriter{mux: m, id: id}, nil
+}
+
+// unaryResult contains the result of a fast-path unary call.
+type unaryResult struct {
+	// data is the response message data.
+	data []byte
+	// err is the call error, if any.
+	err error
+}
+
+// Invoke executes a unary RPC over the shared packet stream.
+//
+// fast path for unary calls: the CallStart is pipelined onto the shared
+// stream and the response is matched by rpc id, without the per-call
+// goroutine and channel machinery of ClientRPC. implements Invoker.
+func (m *PacketMux) Invoke(ctx context.Context, service, method string, in, out Message) error {
+	firstMsg, err := in.MarshalVT()
+	if err != nil {
+		return err
+	}
+	stats := newRPCStats(service, method, true)
+
+	// register the response handler under a fresh rpc id.
+	// frag accumulates chunked response fragments, see SetDataChunkSize.
+	// the handler runs on the connection read loop: no locking needed.
+	// maxRecvBytes applies the per-call limit, see WithMaxResponseSize.
+	maxRecvBytes := maxResponseSizeFromContext(ctx)
+	var frag []byte
+	resCh := make(chan unaryResult, 1)
+	msgHandler := func(pkt *Packet) error {
+		cd, ok := pkt.GetBody().(*Packet_CallData)
+		if !ok {
+			return ErrUnrecognizedPacket
+		}
+		if cd.CallData.GetDataContinued() {
+			// chunked response: accumulate until the final fragment.
+			if len(frag)+len(cd.CallData.GetData()) > int(maxMessageSize) {
+				return errors.Errorf("chunked message size greater than maximum %v", maxMessageSize)
+			}
+			if maxRecvBytes != 0 && len(frag)+len(cd.CallData.GetData()) > maxRecvBytes {
+				return ErrResponseTooLarge
+			}
+			frag = append(frag, cd.CallData.GetData()...)
+			return nil
+		}
+		data := cd.CallData.GetData()
+		if len(frag) != 0 {
+			data = append(frag, data...)
+			frag = nil
+		}
+		if maxRecvBytes != 0 && len(data) > maxRecvBytes {
+			return ErrResponseTooLarge
+		}
+		res := unaryResult{data: data}
+		if errStr := cd.CallData.GetError(); len(errStr) != 0 {
+			res.err = errors.New(errStr)
+		} else if len(res.data) == 0 && !cd.CallData.GetDataIsZero() && cd.CallData.GetComplete() {
+			// completed without a response message
+			res.err = io.EOF
+		}
+		select {
+		case resCh <- res:
+		default:
+		}
+		return nil
+	}
+	closeHandler := func(closeErr error) {
+		if closeErr == nil {
+			closeErr = io.EOF
+		}
+		select {
+		case resCh <- unaryResult{err: closeErr}:
+		default:
+		}
+	}
+	writer, err := m.OpenStream(ctx, msgHandler, closeHandler)
+	if err != nil {
+		return err
+	}
+	defer writer.Close()
+
+	// write the call start & await the response.
+	pkt := NewCallStartPacket(service, method, firstMsg, len(firstMsg) == 0)
+	if deadline, ok := ctx.Deadline(); ok {
+		pkt.GetCallStart().DeadlineUnixMs = deadline.UnixMilli()
+	}
+	if err := writer.WritePacketPooled(pkt); err != nil {
+		stats.complete(err)
+		return err
+	}
+	stats.sentMsg(len(firstMsg))
+	select {
+	case <-ctx.Done():
+		// proactively cancel the rpc on the remote.
+		_ = writer.WritePacketPooled(NewCallCancelPacket())
+		stats.complete(context.Canceled)
+		return context.Canceled
+	case <-m.doneCh:
+		m.mtx.Lock()
+		err := m.closedErr
+		m.mtx.Unlock()
+		if err == nil {
+			err = io.EOF
+		}
+		stats.complete(err)
+		return err
+	case res := <-resCh:
+		if res.err != nil {
+			stats.complete(res.err)
+			return res.err
+		}
+		stats.recvMsg(len(res.data))
+		if err := out.UnmarshalVT(res.data); err != nil {
+			stats.complete(err)
+			return errors.Wrap(ErrInvalidMessage, err.Error())
+		}
+		stats.complete(nil)
+		return nil
+	}
+}
+
+// Wait waits for the packet stream to close.
+// returns the error the stream closed with, if any.
+func (m *PacketMux) Wait(ctx context.Context) error {
+	select {
+	case <-ctx.Done():
+		return context.Canceled
+	case <-m.doneCh:
+	}
+	m.mtx.Lock()
+	err := m.closedErr
+	m.mtx.Unlock()
+	return err
+}
+
+// Close closes the packet stream and all multiplexed rpcs.
+func (m *PacketMux) Close() error {
+	return m.prw.Close()
+}
+
+// handlePacket routes an incoming packet to the rpc matching its id.
+func (m *PacketMux) handlePacket(pkt *Packet) error {
+	id := pkt.GetRpcId()
+	m.mtx.Lock()
+	rpc := m.rpcs[id]
+	m.mtx.Unlock()
+
+	if rpc == nil {
+		_, isCallStart := pkt.GetBody().(*Packet_CallStart)
+		if !isCallStart {
+			// late packet for a completed rpc: drop it.
+			return nil
+		}
+		if m.server == nil {
+			return errors.Wrap(ErrUnrecognizedPacket, "call start packet unexpected")
+		}
+		// admission: reject the call cheaply when over a limit,
+		// before any rpc state is allocated, see NewServerWithLimits.
+		if !m.acquireServerRPC() {
+			outPkt := NewCallDataPacket(nil, false, true, ErrServerOverloaded)
+			outPkt.RpcId = id
+			m.writeMtx.Lock()
+			_ = m.prw.WritePacketPooled(outPkt)
+			m.writeMtx.Unlock()
+			return nil
+		}
+		// incoming call: construct the server rpc & register it.
+		serverRPC := NewServerRPC(m.ctx, m.server.GetMux())
+		serverRPC.SetWriter(&packetMuxWriter{mux: m, id: id})
+		rpc = &packetMuxRPC{
+			handler:      serverRPC.HandlePacket,
+			closeHandler: serverRPC.HandleStreamClose,
+			server:       true,
+		}
+		m.mtx.Lock()
+		m.rpcs[id] = rpc
+		m.mtx.Unlock()
+	}
+
+	// dispatch, closing only this rpc on a handler error.
+	if err := rpc.handler(pkt); err != nil {
+		m.releaseRPC(id)
+		if rpc.closeHandler != nil {
+			rpc.closeHandler(err)
+		}
+		return nil
+	}
+
+	// the initiating side is done once the remote completes the call.
+	if rpc.client {
+		if cd, ok := pkt.GetBody().(*Packet_CallData); ok {
+			if cd.CallData.GetComplete() || cd.CallData.GetError() != "" {
+				m.releaseRPC(id)
+			}
+		}
+	}
+
+	return nil
+}
+
+// handleClose handles the underlying packet stream closing.
+func (m *PacketMux) handleClose(closeErr error) {
+	m.mtx.Lock()
+	if m.closed {
+		m.mtx.Unlock()
+		return
+	}
+	m.closed = true
+	m.closedErr = closeErr
+	rpcs := m.rpcs
+	m.rpcs = nil
+	close(m.doneCh)
+	m.mtx.Unlock()
+
+	for _, rpc := range rpcs {
+		if rpc.closeHandler != nil {
+			rpc.closeHandler(closeErr)
+		}
+		if rpc.server {
+			m.releaseServerRPC()
+		}
+	}
+}
+
+// releaseRPC removes the rpc with the given id, if any.
+func (m *PacketMux) releaseRPC(id uint64) {
+	m.mtx.Lock()
+	var rpc *packetMuxRPC
+	if m.rpcs != nil {
+		rpc = m.rpcs[id]
+		delete(m.rpcs, id)
+	}
+	m.mtx.Unlock()
+	if rpc != nil && rpc.server {
+		m.releaseServerRPC()
+	}
+}
+
+// acquireServerRPC reserves admission for an incoming rpc.
+// returns false if a server limit was reached, see NewServerWithLimits.
+func (m *PacketMux) acquireServerRPC() bool {
+	if maxStreams := m.server.maxConnStreams; maxStreams > 0 {
+		m.mtx.Lock()
+		over := m.serverRPCs >= maxStreams
+		if !over {
+			m.serverRPCs++
+		}
+		m.mtx.Unlock()
+		if over {
+			return false
+		}
+	}
+	if !m.server.tryAcquireRPC() {
+		if m.server.maxConnStreams > 0 {
+			m.mtx.Lock()
+			m.serverRPCs--
+			m.mtx.Unlock()
+		}
+		return false
+	}
+	return true
+}
+
+// releaseServerRPC returns the admission reserved by acquireServerRPC.
+func (m *PacketMux) releaseServerRPC() {
+	if m.server.maxConnStreams > 0 {
+		m.mtx.Lock()
+		m.serverRPCs--
+		m.mtx.Unlock()
+	}
+	m.server.releaseRPC()
+}
+
+// packetMuxWriter writes packets for a single multiplexed rpc.
+type packetMuxWriter struct {
+	// mux is the packet mux
+	mux *PacketMux
+	// id is the rpc id stamped on outgoing packets
+	id uint64
+}
+
+// WritePacket writes a packet to the remote.
+func (w *packetMuxWriter) WritePacket(p *Packet) error {
+	p.RpcId = w.id
+	w.mux.writeMtx.Lock()
+	err := w.mux.prw.WritePacket(p)
+	w.mux.writeMtx.Unlock()
+	return err
+}
+
+// WritePacketPooled writes a packet to the remote with a pooled buffer.
+func (w *packetMuxWriter) WritePacketPooled(p *Packet) error {
+	p.RpcId = w.id
+	w.mux.writeMtx.Lock()
+	err := w.mux.prw.WritePacketPooled(p)
+	w.mux.writeMtx.Unlock()
+	return err
+}
+
+// WritePackets writes a batch of packets coalesced into a single write.
+func (w *packetMuxWriter) WritePackets(pkts []*Packet) error {
+	for _, p := range pkts {
+		p.RpcId = w.id
+	}
+	w.mux.writeMtx.Lock()
+	err := w.mux.prw.WritePackets(pkts)
+	w.mux.writeMtx.Unlock()
+	return err
+}
+
+// Close releases the rpc id without closing the shared packet stream.
+func (w *packetMuxWriter) Close() error {
+	w.mux.releaseRPC(w.id)
+	return nil
+}
+
+// NewClientWithPacketStream constructs a client which multiplexes RPCs
+// over a single packet stream by rpc id, without a stream muxer.
+//
+// the remote must handle the stream with Server.HandlePacketStream.
+func NewClientWithPacketStream(ctx context.Context, rwc io.ReadWriteCloser) Client {
+	pm := NewPacketMux(ctx, rwc, true, nil)
+	return NewClientWithInvoker(pm.OpenStream, pm)
+}
+
+// NewClientWithPacketStreamKeepAlive constructs a packet stream client
+// with keep-alive probes, reaping the connection when the remote goes
+// silent. timeout <= 0 defaults to 3x the interval.
+//
+// the remote must handle the stream with Server.HandlePacketStream.
+// see PacketReaderWriter.SetKeepAlive.
+func NewClientWithPacketStreamKeepAlive(ctx context.Context, rwc io.ReadWriteCloser, interval, timeout time.Duration) Client {
+	prw := NewPacketReadWriter(rwc)
+	prw.SetKeepAlive(interval, timeout)
+	pm := NewPacketMuxWithStream(ctx, prw, true, nil)
+	return NewClientWithInvoker(pm.OpenStream, pm)
+}
+
+// _ is a type assertion
+var _ OpenStreamFunc = ((*PacketMux)(nil)).OpenStream
+
+// _ is a type assertion
+var _ Invoker = ((*PacketMux)(nil))
+
+// _ is a type assertion
+var _ Writer = ((*packetMuxWriter)(nil))
@@ -1,10 +1,12 @@
 package srpc
 
 import (
-	"bytes"
 	"context"
 	"encoding/binary"
 	"io"
+	"sync"
+	"sync/atomic"
+	"time"
 
 	"github.com/pkg/errors"
 )
@@ -17,8 +19,20 @@ var maxMessageSize = 1e7
 type PacketReaderWriter struct {
 	// rw is the io.ReadWriterCloser
 	rw io.ReadWriteCloser
-	// buf is the buffered data
-	buf bytes.Buffer
+	// wmtx serializes frame writes to rw.
+	// the keep-alive pump writes concurrently with rpc goroutines:
+	// interleaved writes would corrupt the framing.
+	wmtx sync.Mutex
+	// keepAliveInterval is the keep-alive send interval, 0 if disabled.
+	keepAliveInterval time.Duration
+	// keepAliveTimeout is the silence duration before reaping the conn.
+	keepAliveTimeout time.Duration
+	// lastRecvNano is the unix nano time of the last received packet.
+	// guarded by atomic.
+	lastRecvNano int64
+	// keepAliveExpired is set when the keep-alive deadline was missed.
+	// guarded by atomic.
+	keepAliveExpired int32
 }
 
 // NewPacketReadWriter constructs a new read/writer.
@@ -26,94 +40,298 @@ func NewPacketReadWriter(rw io.ReadWriteCloser) *PacketReaderWriter {
 	return &PacketReaderWriter{rw: rw}
 }
 
+// writeBufPool pools scratch buffers used to serialize outgoing packets.
+var writeBufPool = sync.Pool{
+	New: func() interface{} {
+		buf := make([]byte, 0, 2048)
+		return &buf
+	},
+}
+
+// readBufTiers are the pooled frame read buffer capacities.
+//
+// each incoming frame draws a right-sized buffer from the smallest
+// fitting tier and returns it after decoding, so idle streams hold no
+// read buffer between frames and bulk streams reuse large buffers
+// instead of allocating per frame. the pools are shared across streams.
+var readBufTiers = [...]int{512, 2048, 8192, 32768, 131072}
+
+// readBufPools pools frame read buffers per tier.
+var readBufPools = func() [len(readBufTiers)]*sync.Pool {
+	var pools [len(readBufTiers)]*sync.Pool
+	for i := range pools {
+		size := readBufTiers[i]
+		pools[i] = &sync.Pool{
+			New: func() interface{} {
+				buf := make([]byte, size)
+				return &buf
+			},
+		}
+	}
+	return pools
+}()
+
+// getReadBuf returns a frame buffer with at least n bytes.
+func getReadBuf(n int) *[]byte {
+	for i, size := range readBufTiers {
+		if n <= size {
+			return readBufPools[i].Get().(*[]byte)
+		}
+	}
+	// larger than the largest tier: not pooled.
+	buf := make([]byte, n)
+	return &buf
+}
+
+// putReadBuf recycles a frame buffer to its tier pool.
+func putReadBuf(bufPtr *[]byte) {
+	bufCap := cap(*bufPtr)
+	for i, size := range readBufTiers {
+		if bufCap == size {
+			*bufPtr = (*bufPtr)[:bufCap]
+			readBufPools[i].Put(bufPtr)
+			return
+		}
+	}
+}
+
 // WritePacket writes a packet to the writer.
 func (r *PacketReaderWriter) WritePacket(p *Packet) error {
+	_, err := r.writePacket(p, nil)
+	return err
+}
+
+// WritePacketPooled writes a packet to the writer using a pooled buffer.
+//
+// the serialization buffer is reused across packets: do not retain
+// references to the marshaled data after the call returns.
+func (r *PacketReaderWriter) WritePacketPooled(p *Packet) error {
+	bufPtr := writeBufPool.Get().(*[]byte)
+	buf, err := r.writePacket(p, *bufPtr)
+	*bufPtr = buf[:0]
+	writeBufPool.Put(bufPtr)
+	return err
+}
+
+// WritePackets writes a batch of packets coalesced into a single write.
+//
+// serializes all length-prefixed frames into one pooled buffer, so the
+// batch reaches the transport as one write instead of one per packet.
+func (r *PacketReaderWriter) WritePackets(pkts []*Packet) error {
+	if len(pkts) == 0 {
+		return nil
+	}
+	if len(pkts) == 1 {
+		return r.WritePacketPooled(pkts[0])
+	}
+
+	// size the frame buffer for the full batch
+	frameSize := 0
+	for _, p := range pkts {
+		frameSize += 4 + p.SizeVT()
+	}
+	bufPtr := writeBufPool.Get().(*[]byte)
+	var data []byte
+	if cap(*bufPtr) >= frameSize {
+		data = (*bufPtr)[:frameSize]
+	} else {
+		data = make([]byte, frameSize)
+	}
+
+	// serialize the length-prefixed frames back to back
+	var err error
+	offset := 0
+	for _, p := range pkts {
+		msgSize := p.SizeVT()
+		binary.LittleEndian.PutUint32(data[offset:], uint32(msgSize))
+		if _, err = p.MarshalToVT(data[offset+4:]); err != nil {
+			break
+		}
+		offset += 4 + msgSize
+	}
+	if err == nil {
+		err = r.writeAll(data)
+	}
+
+	*bufPtr = data[:0]
+	writeBufPool.Put(bufPtr)
+	return err
+}
+
+// writePacket serializes the packet with a length prefix and writes it.
+// scratch is an optional buffer to serialize into, grown if too small.
+// returns the buffer used, which may differ from scratch.
+func (r *PacketReaderWriter) writePacket(p *Packet, scratch []byte) ([]byte, error) {
 	msgSize := p.SizeVT()
-	data := make([]byte, 4+msgSize)
+	frameSize := 4 + msgSize
+	var data []byte
+	if cap(scratch) >= frameSize {
+		data = scratch[:frameSize]
+	} else {
+		data = make([]byte, frameSize)
+	}
 	binary.LittleEndian.PutUint32(data, uint32(msgSize))
-	_, err := p.MarshalToVT(data[4:])
-	if err != nil {
-		return err
+	if _, err := p.MarshalToVT(data[4:]); err != nil {
+		return data, err
 	}
-	var n int
+	return data, r.writeAll(data)
+}
+
+// writeAll writes the full frame buffer to the transport.
+// serialized by wmtx: frames from concurrent writers never interleave.
+func (r *PacketReaderWriter) writeAll(data []byte) error {
+	r.wmtx.Lock()
+	defer r.wmtx.Unlock()
 	written := 0
 	for written < len(data) {
-		n, err = r.rw.Write(data)
+		n, err := r.rw.Write(data[written:])
 		if err != nil {
 			return err
 		}
 		written += n
 	}
+	return nil
+}
+
+// WriteRawPacket writes pre-marshaled packet data with the frame prefix.
+//
+// frames the data into a pooled buffer: the caller may reuse data after
+// the call returns. implements RawWriter, see CallStartPrefix.
+func (r *PacketReaderWriter) WriteRawPacket(data []byte) error {
+	frameSize := 4 + len(data)
+	bufPtr := writeBufPool.Get().(*[]byte)
+	var buf []byte
+	if cap(*bufPtr) >= frameSize {
+		buf = (*bufPtr)[:frameSize]
+	} else {
+		buf = make([]byte, frameSize)
+	}
+	binary.LittleEndian.PutUint32(buf, uint32(len(data)))
+	copy(buf[4:], data)
+	err := r.writeAll(buf)
+	*bufPtr = buf[:0]
+	writeBufPool.Put(bufPtr)
 	return err
 }
 
+// SetKeepAlive enables keep-alive probes on the read pump.
+//
+// every interval the read pump sends a KeepAlive packet and checks how
+// long the remote has been silent: after timeout without any received
+// packet the connection is closed and the close handler observes
+// ErrKeepAliveTimeout. any received packet counts as liveness, so an
+// active connection sends no extra traffic beyond the probes.
+//
+// timeout <= 0 defaults to 3x the interval. must be called before
+// ReadPump. both sides must support the KeepAlive packet: peers predating
+// it fail the rpc on an unrecognized packet.
+func (r *PacketReaderWriter) SetKeepAlive(interval, timeout time.Duration) {
+	if timeout <= 0 {
+		timeout = interval * 3
+	}
+	r.keepAliveInterval = interval
+	r.keepAliveTimeout = timeout
+}
+
 // ReadPump executes the read pump in a goroutine.
 //
 // calls the handler when closed or returning an error
 func (r *PacketReaderWriter) ReadPump(cb PacketHandler, closed CloseHandler) {
+	if r.keepAliveInterval > 0 {
+		atomic.StoreInt64(&r.lastRecvNano, time.Now().UnixNano())
+		stopCh := make(chan struct{})
+		defer close(stopCh)
+		go r.keepAlivePump(stopCh)
+	}
 	err := r.ReadToHandler(cb)
+	if atomic.LoadInt32(&r.keepAliveExpired) != 0 {
+		err = ErrKeepAliveTimeout
+	}
 	// signal that the stream is now closed.
 	if closed != nil {
 		closed(err)
 	}
 }
 
+// keepAlivePump sends keep-alive probes and reaps the conn on silence.
+func (r *PacketReaderWriter) keepAlivePump(stopCh <-chan struct{}) {
+	tkr := time.NewTicker(r.keepAliveInterval)
+	defer tkr.Stop()
+	for {
+		select {
+		case <-stopCh:
+			return
+		case <-tkr.C:
+		}
+		lastRecv := time.Unix(0, atomic.LoadInt64(&r.lastRecvNano))
+		if time.Since(lastRecv) > r.keepAliveTimeout {
+			// the remote went silent: reap the connection.
+			atomic.StoreInt32(&r.keepAliveExpired, 1)
+			_ = r.Close()
+			return
+		}
+		_ = r.WritePacketPooled(NewKeepAlivePacket())
+	}
+}
+
 // ReadToHandler reads data to the given handler.
 // Does not handle closing the stream, use ReadPump instead.
 func (r *PacketReaderWriter) ReadToHandler(cb PacketHandler) error {
-	var currLen uint32
-	buf := make([]byte, 2048)
-	isOpen := true
-	for isOpen {
-		// read some data into the buffer
-		n, err := r.rw.Read(buf)
-		if err != nil {
-			if err == io.EOF || err == context.Canceled {
-				isOpen = false
-			} else {
-				return err
+	var prefix [4]byte
+	for {
+		// read the length prefix
+		if _, err := io.ReadFull(r.rw, prefix[:]); err != nil {
+			if err == io.EOF || err == io.ErrUnexpectedEOF || err == context.Canceled {
+				// closed
+				return nil
 			}
+			return err
+		}
+		currLen := binary.LittleEndian.Uint32(prefix[:])
+		if currLen == 0 {
+			return errors.New("unexpected zero len prefix")
+		}
+		if currLen > uint32(maxMessageSize) {
+			return errors.Errorf("message size %v greater than maximum %v", currLen, maxMessageSize)
 		}
 
-		// push the data to r.buf
-		_, err = r.buf.Write(buf[:n])
-		if err != nil {
+		// read the packet into a pooled right-sized buffer
+		bufPtr := getReadBuf(int(currLen))
+		pkt := (*bufPtr)[:currLen]
+		if _, err := io.ReadFull(r.rw, pkt); err != nil {
+			putReadBuf(bufPtr)
+			if err == io.EOF {
+				err = io.ErrUnexpectedEOF
+			}
 			return err
 		}
 
-		// check if we have enough data for a length prefix
-		bufLen := r.buf.Len()
-		if bufLen < 4 {
-			continue
+		// any received packet counts as keep-alive liveness.
+		if r.keepAliveInterval > 0 {
+			atomic.StoreInt64(&r.lastRecvNano, time.Now().UnixNano())
 		}
 
-		// parse the length prefix if not done already
-		if currLen == 0 {
-			currLen = r.readLengthPrefix(r.buf.Bytes())
-			if currLen == 0 {
-				return errors.New("unexpected zero len prefix")
-			}
-			if currLen > uint32(maxMessageSize) {
-				return errors.Errorf("message size %v greater than maximum %v", currLen, maxMessageSize)
-			}
+		// decode and emit the packet, returning it to the pool after.
+		npkt := GetPacket()
+		err := npkt.UnmarshalVT(pkt)
+		// UnmarshalVT copies all fields out of the frame buffer, so it
+		// recycles immediately. the payload slices handed to the handler
+		// are fresh copies which consumers may retain, see ReleasePacket:
+		// those cannot recycle here.
+		putReadBuf(bufPtr)
+		if err == nil && npkt.GetKeepAlive() != nil {
+			// liveness probe: consumed here, not routed to an rpc.
+			ReleasePacket(npkt)
+			continue
 		}
-
-		// emit the packet if fully buffered
-		if currLen != 0 && bufLen >= int(currLen)+4 {
-			pkt := r.buf.Next(int(currLen + 4))[4:]
-			currLen = 0
-			npkt := &Packet{}
-			if err := npkt.UnmarshalVT(pkt); err != nil {
-				return err
-			}
-			if err := cb(npkt); err != nil {
-				return err
-			}
+		if err == nil {
+			err = cb(npkt)
+		}
+		ReleasePacket(npkt)
+		if err != nil {
+			return err
 		}
 	}
-
-	// closed
-	return nil
 }
 
 // Close closes the packet rw.
@@ -121,13 +339,8 @@ func (r *PacketReaderWriter) Close() error {
 	return r.rw.Close()
 }
 
-// readLengthPrefix reads the length prefix.
-func (r *PacketReaderWriter) readLengthPrefix(b []byte) uint32 {
-	if len(b) < 4 {
-		return 0
-	}
-	return binary.LittleEndian.Uint32(b)
-}
-
 // _ is a type assertion
 var _ Writer = (*PacketReaderWriter)(nil)
+
+// _ is a type assertion
+var _ PacketStream = (*PacketReaderWriter)(nil)
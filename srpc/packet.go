@@ -1,11 +1,58 @@
 package srpc
 
+import "sync"
+
 // PacketHandler handles a packet.
 //
 // pkt is optional (can be nil)
 // if closeErr is set, the stream is closed after pkt.
+//
+// the packet may be pooled: the handler must not retain references to
+// the packet or its body after returning. byte slices extracted from
+// the body stay valid after the packet is released.
 type PacketHandler = func(pkt *Packet) error
 
+// packetPool pools Packet objects used on the decode hot path.
+var packetPool = sync.Pool{
+	New: func() interface{} {
+		return &Packet{}
+	},
+}
+
+// GetPacket returns a Packet from the shared pool.
+// release it with ReleasePacket when no longer in use.
+func GetPacket() *Packet {
+	return packetPool.Get().(*Packet)
+}
+
+// ReleasePacket resets the packet and returns it to the shared pool.
+//
+// the caller must not retain references to the packet or its body.
+// the body data slices are detached by the reset, so byte slices
+// extracted from the body remain valid after release.
+func ReleasePacket(p *Packet) {
+	if p == nil {
+		return
+	}
+	// detach the data slices: the next unmarshal would otherwise
+	// overwrite buffers the previous handler may still reference.
+	switch b := p.Body.(type) {
+	case *Packet_CallStart:
+		if cs := b.CallStart; cs != nil {
+			*cs = CallStart{}
+		}
+	case *Packet_CallData:
+		if cd := b.CallData; cd != nil {
+			*cd = CallData{}
+		}
+	default:
+		p.Body = nil
+	}
+	p.RpcId = 0
+	p.unknownFields = nil
+	packetPool.Put(p)
+}
+
 // CloseHandler handles the stream closing with an optional error.
 type CloseHandler = func(closeErr error)
 
@@ -16,6 +63,10 @@ func (p *Packet) Validate() error {
 		return b.CallStart.Validate()
 	case *Packet_CallData:
 		return b.CallData.Validate()
+	case *Packet_CallCancel:
+		return nil
+	case *Packet_KeepAlive:
+		return nil
 	default:
 		return ErrUnrecognizedPacket
 	}
@@ -62,6 +113,31 @@ func NewCallDataPacket(data []byte, dataIsZero bool, complete bool, err error) *
 	}}
 }
 
+// NewCallDataContinuedPacket constructs a CallData packet containing a
+// fragment of a chunked message which continues in the next packet.
+func NewCallDataContinuedPacket(data []byte) *Packet {
+	return &Packet{Body: &Packet_CallData{
+		CallData: &CallData{
+			Data:          data,
+			DataContinued: true,
+		},
+	}}
+}
+
+// NewCallCancelPacket constructs a new CallCancel packet.
+func NewCallCancelPacket() *Packet {
+	return &Packet{Body: &Packet_CallCancel{
+		CallCancel: &CallCancel{},
+	}}
+}
+
+// NewKeepAlivePacket constructs a new KeepAlive packet.
+func NewKeepAlivePacket() *Packet {
+	return &Packet{Body: &Packet_KeepAlive{
+		KeepAlive: &KeepAlive{},
+	}}
+}
+
 // Validate performs cursory validation of the packet.
 func (p *CallData) Validate() error {
 	if len(p.GetData()) == 0 && !p.GetComplete() && len(p.GetError()) == 0 && !p.GetDataIsZero() {
@@ -1,13 +1,116 @@
-import { Pushable } from 'it-pushable'
+// defaultHighWaterMark bounds the pushable queues unless overridden.
+const defaultHighWaterMark = 8
+
+// BoundedPushable is an AsyncIterable queue with backpressure.
+//
+// push resolves immediately while the queue is below the high-water
+// mark and otherwise waits until the consumer drains below it, so a
+// fast producer is throttled by actual consumer progress instead of
+// buffering without bound.
+export class BoundedPushable<T> implements AsyncIterable<T> {
+  // queue contains the pushed values not yet consumed.
+  private queue: T[] = []
+  // highWaterMark is the queue length at which push blocks.
+  private readonly highWaterMark: number
+  // ended indicates end was called.
+  private ended = false
+  // err is the error passed to end, if any.
+  private err?: Error
+  // pullWaiter resolves when a value is pushed or the queue ends.
+  private pullWaiter?: () => void
+  // pushWaiters resolve when the queue drains below the high-water mark.
+  private pushWaiters: (() => void)[] = []
+
+  constructor(highWaterMark?: number) {
+    this.highWaterMark = highWaterMark || defaultHighWaterMark
+  }
+
+  // length returns the number of queued values.
+  get length(): number {
+    return this.queue.length
+  }
+
+  // isEnded indicates end was called.
+  get isEnded(): boolean {
+    return this.ended
+  }
+
+  // push enqueues a value, resolving when the queue has capacity.
+  public push(val: T): Promise<void> {
+    if (this.ended) {
+      return Promise.reject(this.err || new Error('pushable ended'))
+    }
+    this.queue.push(val)
+    this.wakePull()
+    if (this.queue.length < this.highWaterMark) {
+      return Promise.resolve()
+    }
+    return new Promise<void>((resolve) => {
+      this.pushWaiters.push(resolve)
+    })
+  }
+
+  // end marks the queue as complete, optionally with an error.
+  // queued values are still emitted before the iterator completes.
+  public end(err?: Error) {
+    if (this.ended) {
+      return
+    }
+    this.ended = true
+    this.err = err
+    this.wakePull()
+    this.wakePush()
+  }
+
+  // wakePull wakes the waiting consumer, if any.
+  private wakePull() {
+    const waiter = this.pullWaiter
+    if (waiter) {
+      this.pullWaiter = undefined
+      waiter()
+    }
+  }
+
+  // wakePush wakes all producers waiting for capacity.
+  private wakePush() {
+    const waiters = this.pushWaiters
+    this.pushWaiters = []
+    for (const waiter of waiters) {
+      waiter()
+    }
+  }
+
+  async *[Symbol.asyncIterator](): AsyncIterator<T> {
+    for (;;) {
+      while (this.queue.length) {
+        const val = this.queue.shift()!
+        if (this.queue.length < this.highWaterMark) {
+          this.wakePush()
+        }
+        yield val
+      }
+      if (this.ended) {
+        if (this.err) {
+          throw this.err
+        }
+        return
+      }
+      await new Promise<void>((resolve) => {
+        this.pullWaiter = resolve
+      })
+    }
+  }
+}
 
 // writeToPushable writes the incoming server data to the pushable.
+// awaits each push: bounded pushables throttle the data source.
 export async function writeToPushable<T>(
   dataSource: AsyncIterable<T>,
-  out: Pushable<T>
+  out: { push: (val: T) => unknown; end: (err?: Error) => void }
 ) {
   try {
     for await (const data of dataSource) {
-      out.push(data)
+      await out.push(data)
     }
     out.end()
   } catch (err) {
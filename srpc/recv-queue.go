@@ -0,0 +1,220 @@
+package srpc
+
+import (
+	"context"
+	"io"
+	"sync"
+	"time"
+
+	"github.com/pkg/errors"
+)
+
+var (
+	// defaultRecvWindowMsgs is the default receive window in messages.
+	defaultRecvWindowMsgs = 5
+	// defaultRecvWindowBytes is the default receive window in bytes.
+	defaultRecvWindowBytes = 1 << 20
+	// recvWindowStallTimeout bounds how long a push waits on a full window.
+	recvWindowStallTimeout = 30 * time.Second
+)
+
+// SetReceiveWindow configures the receive window applied to new RPCs.
+//
+// maxMsgs bounds the number of queued incoming messages, maxBytes the
+// total queued bytes; zero disables the respective bound. A message
+// larger than the byte window is still accepted when the queue is
+// empty. When the window is full the connection read pump blocks,
+// applying backpressure through the transport.
+//
+// note: on a shared packet stream (see PacketMux) all rpcs ride one
+// read loop, so a full window stalls every rpc on the connection behind
+// the slow one until it drains. the wait is bounded, see
+// SetReceiveWindowStallTimeout.
+func SetReceiveWindow(maxMsgs, maxBytes int) {
+	defaultRecvWindowMsgs = maxMsgs
+	defaultRecvWindowBytes = maxBytes
+}
+
+// SetReceiveWindowStallTimeout bounds how long the connection read loop
+// waits on an rpc whose receive window is full before failing that rpc
+// with ErrRecvWindowStalled. applies to new pushes.
+func SetReceiveWindowStallTimeout(timeout time.Duration) {
+	recvWindowStallTimeout = timeout
+}
+
+// recvMsg is a queued incoming message or message fragment.
+type recvMsg struct {
+	// data is the message data.
+	data []byte
+	// continued indicates the message continues in the next entry.
+	continued bool
+}
+
+// recvQueue buffers incoming rpc data with message and byte bounds.
+//
+// push is called by at most one goroutine (the connection read pump)
+// and pop by at most one goroutine (the rpc consumer).
+type recvQueue struct {
+	// maxMsgs bounds the queued messages. 0 = unbounded.
+	maxMsgs int
+	// maxBytes bounds the total queued bytes. 0 = unbounded.
+	maxBytes int
+
+	// mtx guards below fields
+	mtx sync.Mutex
+	// list contains the queued messages.
+	list []recvMsg
+	// bytes is the total size of the queued messages.
+	bytes int
+	// closed indicates no more messages will be pushed.
+	closed bool
+
+	// readCh is signaled when data is pushed or the queue closes.
+	readCh chan struct{}
+	// writeCh is signaled when data is popped or the queue closes.
+	writeCh chan struct{}
+}
+
+// newRecvQueue constructs a recvQueue with the default window.
+func newRecvQueue() *recvQueue {
+	return &recvQueue{
+		maxMsgs:  defaultRecvWindowMsgs,
+		maxBytes: defaultRecvWindowBytes,
+		readCh:   make(chan struct{}, 1),
+		writeCh:  make(chan struct{}, 1),
+	}
+}
+
+// push appends data to the queue, blocking while the window is full.
+// continued indicates the message continues in the next entry.
+// returns ErrCompleted if the queue is closed.
+//
+// push runs on the connection read loop: on a shared packet stream a
+// full window stalls every rpc on the connection behind this one. the
+// wait is therefore bounded: if the consumer does not drain the window
+// within recvWindowStallTimeout the push fails with
+// ErrRecvWindowStalled, failing only this rpc.
+func (q *recvQueue) push(ctx context.Context, data []byte, continued bool) error {
+	var stallC <-chan time.Time
+	for {
+		q.mtx.Lock()
+		if q.closed {
+			q.mtx.Unlock()
+			return ErrCompleted
+		}
+		withinMsgs := q.maxMsgs == 0 || len(q.list) < q.maxMsgs
+		withinBytes := q.maxBytes == 0 || q.bytes+len(data) <= q.maxBytes || len(q.list) == 0
+		if withinMsgs && withinBytes {
+			q.list = append(q.list, recvMsg{data: data, continued: continued})
+			q.bytes += len(data)
+			q.mtx.Unlock()
+			q.signal(q.readCh)
+			return nil
+		}
+		q.mtx.Unlock()
+
+		if stallC == nil && recvWindowStallTimeout > 0 {
+			tmr := time.NewTimer(recvWindowStallTimeout)
+			defer tmr.Stop()
+			stallC = tmr.C
+		}
+		select {
+		case <-ctx.Done():
+			return context.Canceled
+		case <-stallC:
+			return ErrRecvWindowStalled
+		case <-q.writeCh:
+		}
+	}
+}
+
+// tryPush appends data to the queue without blocking.
+// returns false if the window is full or the queue is closed.
+func (q *recvQueue) tryPush(data []byte) bool {
+	q.mtx.Lock()
+	defer q.mtx.Unlock()
+	if q.closed {
+		return false
+	}
+	if q.maxMsgs != 0 && len(q.list) >= q.maxMsgs {
+		return false
+	}
+	if q.maxBytes != 0 && q.bytes+len(data) > q.maxBytes && len(q.list) != 0 {
+		return false
+	}
+	q.list = append(q.list, recvMsg{data: data})
+	q.bytes += len(data)
+	q.signal(q.readCh)
+	return true
+}
+
+// pop dequeues the next entry, blocking while the queue is empty.
+// returns ok=false if the queue closed and has fully drained.
+func (q *recvQueue) pop(ctx context.Context) (msg recvMsg, ok bool, err error) {
+	for {
+		q.mtx.Lock()
+		if len(q.list) != 0 {
+			msg = q.list[0]
+			copy(q.list, q.list[1:])
+			q.list[len(q.list)-1] = recvMsg{}
+			q.list = q.list[:len(q.list)-1]
+			q.bytes -= len(msg.data)
+			q.mtx.Unlock()
+			q.signal(q.writeCh)
+			return msg, true, nil
+		}
+		closed := q.closed
+		q.mtx.Unlock()
+		if closed {
+			return recvMsg{}, false, nil
+		}
+
+		select {
+		case <-ctx.Done():
+			return recvMsg{}, false, context.Canceled
+		case <-q.readCh:
+		}
+	}
+}
+
+// popFull dequeues the next logical message, joining chunked fragments.
+// returns ok=false if the queue closed and has fully drained.
+func (q *recvQueue) popFull(ctx context.Context) (data []byte, ok bool, err error) {
+	msg, ok, err := q.pop(ctx)
+	if err != nil || !ok || !msg.continued {
+		return msg.data, ok, err
+	}
+	data = msg.data
+	for msg.continued {
+		msg, ok, err = q.pop(ctx)
+		if err != nil {
+			return nil, false, err
+		}
+		if !ok {
+			// the queue closed mid-message
+			return nil, false, io.ErrUnexpectedEOF
+		}
+		if len(data)+len(msg.data) > int(maxMessageSize) {
+			return nil, false, errors.Errorf("chunked message size greater than maximum %v", maxMessageSize)
+		}
+		data = append(data, msg.data...)
+	}
+	return data, true, nil
+}
+
+// close marks the queue closed: push fails, pop drains then reports ok=false.
+func (q *recvQueue) close() {
+	q.mtx.Lock()
+	q.closed = true
+	q.mtx.Unlock()
+	q.signal(q.readCh)
+	q.signal(q.writeCh)
+}
+
+// signal performs a non-blocking signal on the notify channel.
+func (q *recvQueue) signal(ch chan struct{}) {
+	select {
+	case ch <- struct{}{}:
+	default:
+	}
+}
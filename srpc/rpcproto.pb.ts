@@ -9,6 +9,14 @@ export interface Packet {
   body?:
     | { $case: 'callStart'; callStart: CallStart }
     | { $case: 'callData'; callData: CallData }
+    | { $case: 'callCancel'; callCancel: CallCancel }
+    | { $case: 'keepAlive'; keepAlive: KeepAlive }
+  /**
+   * RpcId identifies the RPC this packet belongs to when multiple RPCs
+   * are multiplexed over a single packet stream.
+   * Zero when each RPC has a dedicated transport stream.
+   */
+  rpcId: Long
 }
 
 /** CallStart requests starting a new RPC call. */
@@ -30,6 +38,17 @@ export interface CallStart {
   data: Uint8Array
   /** DataIsZero indicates Data is set with an empty message. */
   dataIsZero: boolean
+  /**
+   * DataCompress is the compression codec applied to message data on
+   * this RPC, including the Data field above.
+   * Zero indicates no compression.
+   */
+  dataCompress: number
+  /**
+   * DeadlineUnixMs is the client deadline for the call as a unix
+   * timestamp in milliseconds. Zero indicates no deadline.
+   */
+  deadlineUnixMs: Long
 }
 
 /** CallData contains a message in a streaming RPC sequence. */
@@ -45,10 +64,29 @@ export interface CallData {
    * If set, implies complete=true.
    */
   error: string
+  /**
+   * DataContinued indicates Data is a fragment of a chunked message
+   * which continues in the next CallData packet.
+   */
+  dataContinued: boolean
 }
 
+/**
+ * CallCancel cancels an in-progress RPC call.
+ * sent by the client to proactively tear down remote work when the
+ * call context is canceled.
+ */
+export interface CallCancel {}
+
+/**
+ * KeepAlive probes connection liveness.
+ * either side may send it at any time; the receiver consumes it in the
+ * read pump without routing it to an RPC.
+ */
+export interface KeepAlive {}
+
 function createBasePacket(): Packet {
-  return { body: undefined }
+  return { body: undefined, rpcId: Long.UZERO }
 }
 
 export const Packet = {
@@ -65,6 +103,21 @@ export const Packet = {
     if (message.body?.$case === 'callData') {
       CallData.encode(message.body.callData, writer.uint32(18).fork()).ldelim()
     }
+    if (message.body?.$case === 'callCancel') {
+      CallCancel.encode(
+        message.body.callCancel,
+        writer.uint32(34).fork()
+      ).ldelim()
+    }
+    if (message.body?.$case === 'keepAlive') {
+      KeepAlive.encode(
+        message.body.keepAlive,
+        writer.uint32(42).fork()
+      ).ldelim()
+    }
+    if (!message.rpcId.isZero()) {
+      writer.uint32(24).uint64(message.rpcId)
+    }
     return writer
   },
 
@@ -87,6 +140,21 @@ export const Packet = {
             callData: CallData.decode(reader, reader.uint32()),
           }
           break
+        case 3:
+          message.rpcId = reader.uint64() as Long
+          break
+        case 4:
+          message.body = {
+            $case: 'callCancel',
+            callCancel: CallCancel.decode(reader, reader.uint32()),
+          }
+          break
+        case 5:
+          message.body = {
+            $case: 'keepAlive',
+            keepAlive: KeepAlive.decode(reader, reader.uint32()),
+          }
+          break
         default:
           reader.skipType(tag & 7)
           break
@@ -138,7 +206,15 @@ export const Packet = {
           }
         : isSet(object.callData)
         ? { $case: 'callData', callData: CallData.fromJSON(object.callData) }
+        : isSet(object.callCancel)
+        ? {
+            $case: 'callCancel',
+            callCancel: CallCancel.fromJSON(object.callCancel),
+          }
+        : isSet(object.keepAlive)
+        ? { $case: 'keepAlive', keepAlive: KeepAlive.fromJSON(object.keepAlive) }
         : undefined,
+      rpcId: isSet(object.rpcId) ? Long.fromValue(object.rpcId) : Long.UZERO,
     }
   },
 
@@ -152,6 +228,16 @@ export const Packet = {
       (obj.callData = message.body?.callData
         ? CallData.toJSON(message.body?.callData)
         : undefined)
+    message.body?.$case === 'callCancel' &&
+      (obj.callCancel = message.body?.callCancel
+        ? CallCancel.toJSON(message.body?.callCancel)
+        : undefined)
+    message.body?.$case === 'keepAlive' &&
+      (obj.keepAlive = message.body?.keepAlive
+        ? KeepAlive.toJSON(message.body?.keepAlive)
+        : undefined)
+    message.rpcId !== undefined &&
+      (obj.rpcId = (message.rpcId || Long.UZERO).toString())
     return obj
   },
 
@@ -177,6 +263,29 @@ export const Packet = {
         callData: CallData.fromPartial(object.body.callData),
       }
     }
+    if (
+      object.body?.$case === 'callCancel' &&
+      object.body?.callCancel !== undefined &&
+      object.body?.callCancel !== null
+    ) {
+      message.body = {
+        $case: 'callCancel',
+        callCancel: CallCancel.fromPartial(object.body.callCancel),
+      }
+    }
+    if (
+      object.body?.$case === 'keepAlive' &&
+      object.body?.keepAlive !== undefined &&
+      object.body?.keepAlive !== null
+    ) {
+      message.body = {
+        $case: 'keepAlive',
+        keepAlive: KeepAlive.fromPartial(object.body.keepAlive),
+      }
+    }
+    if (object.rpcId !== undefined && object.rpcId !== null) {
+      message.rpcId = Long.fromValue(object.rpcId)
+    }
     return message
   },
 }
@@ -187,6 +296,8 @@ function createBaseCallStart(): CallStart {
     rpcMethod: '',
     data: new Uint8Array(),
     dataIsZero: false,
+    dataCompress: 0,
+    deadlineUnixMs: Long.ZERO,
   }
 }
 
@@ -207,6 +318,12 @@ export const CallStart = {
     if (message.dataIsZero === true) {
       writer.uint32(32).bool(message.dataIsZero)
     }
+    if (message.dataCompress !== 0) {
+      writer.uint32(40).uint32(message.dataCompress)
+    }
+    if (!message.deadlineUnixMs.isZero()) {
+      writer.uint32(48).int64(message.deadlineUnixMs)
+    }
     return writer
   },
 
@@ -229,6 +346,12 @@ export const CallStart = {
         case 4:
           message.dataIsZero = reader.bool()
           break
+        case 5:
+          message.dataCompress = reader.uint32()
+          break
+        case 6:
+          message.deadlineUnixMs = reader.int64() as Long
+          break
         default:
           reader.skipType(tag & 7)
           break
@@ -281,6 +404,12 @@ export const CallStart = {
         ? bytesFromBase64(object.data)
         : new Uint8Array(),
       dataIsZero: isSet(object.dataIsZero) ? Boolean(object.dataIsZero) : false,
+      dataCompress: isSet(object.dataCompress)
+        ? Number(object.dataCompress)
+        : 0,
+      deadlineUnixMs: isSet(object.deadlineUnixMs)
+        ? Long.fromValue(object.deadlineUnixMs)
+        : Long.ZERO,
     }
   },
 
@@ -293,6 +422,10 @@ export const CallStart = {
         message.data !== undefined ? message.data : new Uint8Array()
       ))
     message.dataIsZero !== undefined && (obj.dataIsZero = message.dataIsZero)
+    message.dataCompress !== undefined &&
+      (obj.dataCompress = Math.round(message.dataCompress))
+    message.deadlineUnixMs !== undefined &&
+      (obj.deadlineUnixMs = (message.deadlineUnixMs || Long.ZERO).toString())
     return obj
   },
 
@@ -304,6 +437,10 @@ export const CallStart = {
     message.rpcMethod = object.rpcMethod ?? ''
     message.data = object.data ?? new Uint8Array()
     message.dataIsZero = object.dataIsZero ?? false
+    message.dataCompress = object.dataCompress ?? 0
+    if (object.deadlineUnixMs !== undefined && object.deadlineUnixMs !== null) {
+      message.deadlineUnixMs = Long.fromValue(object.deadlineUnixMs)
+    }
     return message
   },
 }
@@ -314,6 +451,7 @@ function createBaseCallData(): CallData {
     dataIsZero: false,
     complete: false,
     error: '',
+    dataContinued: false,
   }
 }
 
@@ -334,6 +472,9 @@ export const CallData = {
     if (message.error !== '') {
       writer.uint32(34).string(message.error)
     }
+    if (message.dataContinued === true) {
+      writer.uint32(40).bool(message.dataContinued)
+    }
     return writer
   },
 
@@ -356,6 +497,9 @@ export const CallData = {
         case 4:
           message.error = reader.string()
           break
+        case 5:
+          message.dataContinued = reader.bool()
+          break
         default:
           reader.skipType(tag & 7)
           break
@@ -408,6 +552,9 @@ export const CallData = {
       dataIsZero: isSet(object.dataIsZero) ? Boolean(object.dataIsZero) : false,
       complete: isSet(object.complete) ? Boolean(object.complete) : false,
       error: isSet(object.error) ? String(object.error) : '',
+      dataContinued: isSet(object.dataContinued)
+        ? Boolean(object.dataContinued)
+        : false,
     }
   },
 
@@ -420,6 +567,8 @@ export const CallData = {
     message.dataIsZero !== undefined && (obj.dataIsZero = message.dataIsZero)
     message.complete !== undefined && (obj.complete = message.complete)
     message.error !== undefined && (obj.error = message.error)
+    message.dataContinued !== undefined &&
+      (obj.dataContinued = message.dataContinued)
     return obj
   },
 
@@ -429,6 +578,163 @@ export const CallData = {
     message.dataIsZero = object.dataIsZero ?? false
     message.complete = object.complete ?? false
     message.error = object.error ?? ''
+    message.dataContinued = object.dataContinued ?? false
+    return message
+  },
+}
+
+function createBaseCallCancel(): CallCancel {
+  return {}
+}
+
+export const CallCancel = {
+  encode(
+    _: CallCancel,
+    writer: _m0.Writer = _m0.Writer.create()
+  ): _m0.Writer {
+    return writer
+  },
+
+  decode(input: _m0.Reader | Uint8Array, length?: number): CallCancel {
+    const reader = input instanceof _m0.Reader ? input : new _m0.Reader(input)
+    let end = length === undefined ? reader.len : reader.pos + length
+    const message = createBaseCallCancel()
+    while (reader.pos < end) {
+      const tag = reader.uint32()
+      switch (tag >>> 3) {
+        default:
+          reader.skipType(tag & 7)
+          break
+      }
+    }
+    return message
+  },
+
+  // encodeTransform encodes a source of message objects.
+  // Transform<CallCancel, Uint8Array>
+  async *encodeTransform(
+    source:
+      | AsyncIterable<CallCancel | CallCancel[]>
+      | Iterable<CallCancel | CallCancel[]>
+  ): AsyncIterable<Uint8Array> {
+    for await (const pkt of source) {
+      if (Array.isArray(pkt)) {
+        for (const p of pkt) {
+          yield* [CallCancel.encode(p).finish()]
+        }
+      } else {
+        yield* [CallCancel.encode(pkt).finish()]
+      }
+    }
+  },
+
+  // decodeTransform decodes a source of encoded messages.
+  // Transform<Uint8Array, CallCancel>
+  async *decodeTransform(
+    source:
+      | AsyncIterable<Uint8Array | Uint8Array[]>
+      | Iterable<Uint8Array | Uint8Array[]>
+  ): AsyncIterable<CallCancel> {
+    for await (const pkt of source) {
+      if (Array.isArray(pkt)) {
+        for (const p of pkt) {
+          yield* [CallCancel.decode(p)]
+        }
+      } else {
+        yield* [CallCancel.decode(pkt)]
+      }
+    }
+  },
+
+  fromJSON(_: any): CallCancel {
+    return {}
+  },
+
+  toJSON(_: CallCancel): unknown {
+    const obj: any = {}
+    return obj
+  },
+
+  fromPartial<I extends Exact<DeepPartial<CallCancel>, I>>(_: I): CallCancel {
+    const message = createBaseCallCancel()
+    return message
+  },
+}
+
+function createBaseKeepAlive(): KeepAlive {
+  return {}
+}
+
+export const KeepAlive = {
+  encode(
+    _: KeepAlive,
+    writer: _m0.Writer = _m0.Writer.create()
+  ): _m0.Writer {
+    return writer
+  },
+
+  decode(input: _m0.Reader | Uint8Array, length?: number): KeepAlive {
+    const reader = input instanceof _m0.Reader ? input : new _m0.Reader(input)
+    let end = length === undefined ? reader.len : reader.pos + length
+    const message = createBaseKeepAlive()
+    while (reader.pos < end) {
+      const tag = reader.uint32()
+      switch (tag >>> 3) {
+        default:
+          reader.skipType(tag & 7)
+          break
+      }
+    }
+    return message
+  },
+
+  // encodeTransform encodes a source of message objects.
+  // Transform<KeepAlive, Uint8Array>
+  async *encodeTransform(
+    source:
+      | AsyncIterable<KeepAlive | KeepAlive[]>
+      | Iterable<KeepAlive | KeepAlive[]>
+  ): AsyncIterable<Uint8Array> {
+    for await (const pkt of source) {
+      if (Array.isArray(pkt)) {
+        for (const p of pkt) {
+          yield* [KeepAlive.encode(p).finish()]
+        }
+      } else {
+        yield* [KeepAlive.encode(pkt).finish()]
+      }
+    }
+  },
+
+  // decodeTransform decodes a source of encoded messages.
+  // Transform<Uint8Array, KeepAlive>
+  async *decodeTransform(
+    source:
+      | AsyncIterable<Uint8Array | Uint8Array[]>
+      | Iterable<Uint8Array | Uint8Array[]>
+  ): AsyncIterable<KeepAlive> {
+    for await (const pkt of source) {
+      if (Array.isArray(pkt)) {
+        for (const p of pkt) {
+          yield* [KeepAlive.decode(p)]
+        }
+      } else {
+        yield* [KeepAlive.decode(pkt)]
+      }
+    }
+  },
+
+  fromJSON(_: any): KeepAlive {
+    return {}
+  },
+
+  toJSON(_: KeepAlive): unknown {
+    const obj: any = {}
+    return obj
+  },
+
+  fromPartial<I extends Exact<DeepPartial<KeepAlive>, I>>(_: I): KeepAlive {
+    const message = createBaseKeepAlive()
     return message
   },
 }
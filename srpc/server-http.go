@@ -30,7 +30,9 @@ func (s *HTTPServer) ServeHTTP(w http.ResponseWriter, r *http.Request) {
 		return
 	}
 
-	c, err := websocket.Accept(w, r, &websocket.AcceptOptions{})
+	c, err := websocket.Accept(w, r, &websocket.AcceptOptions{
+		Subprotocols: []string{WebSocketSubprotocol},
+	})
 	if err != nil {
 		// TODO: handle / log error?
 		_ = err
@@ -39,6 +41,16 @@ func (s *HTTPServer) ServeHTTP(w http.ResponseWriter, r *http.Request) {
 	defer c.Close(websocket.StatusInternalError, "closed")
 
 	ctx := r.Context()
+
+	// direct packet framing mode: each binary websocket message is one
+	// Packet, with concurrency over the rpc id mux, skipping the stream
+	// muxer layer entirely. negotiated via the websocket subprotocol.
+	if c.Subprotocol() == WebSocketSubprotocol {
+		pm := NewWebSocketPacketMux(ctx, c, false, s.srpc)
+		_ = pm.Wait(ctx)
+		return
+	}
+
 	wsConn, err := NewWebSocketConn(ctx, c, true)
 	if err != nil {
 		// TODO: handle / log error?
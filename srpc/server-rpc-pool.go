@@ -0,0 +1,99 @@
+package srpc
+
+import (
+	"context"
+	"io"
+	"sync/atomic"
+)
+
+// serverRPCBlock bundles the per-RPC server state into one allocation.
+//
+// a ServerRPC, its receive queue, its message stream, and its packet
+// read/writer die together when the rpc ends: allocating them as one
+// block recycled through the server's pool removes the short-lived
+// object cluster each incoming stream otherwise creates.
+type serverRPCBlock struct {
+	// rpc is the embedded rpc state.
+	rpc ServerRPC
+	// queue is the embedded receive queue storage.
+	queue recvQueue
+	// prw is the embedded packet read/writer.
+	prw PacketReaderWriter
+	// refs counts the goroutines holding the block.
+	// guarded by atomic. the block recycles when it reaches zero.
+	refs int32
+	// srv is the owning server which recycles the block.
+	srv *Server
+}
+
+// newServerRPCBlock constructs an empty block.
+func newServerRPCBlock(srv *Server) *serverRPCBlock {
+	b := &serverRPCBlock{srv: srv}
+	b.queue.readCh = make(chan struct{}, 1)
+	b.queue.writeCh = make(chan struct{}, 1)
+	return b
+}
+
+// getRPCBlock pops a block from the server pool or constructs one.
+func (s *Server) getRPCBlock() *serverRPCBlock {
+	if v := s.rpcPool.Get(); v != nil {
+		return v.(*serverRPCBlock)
+	}
+	return newServerRPCBlock(s)
+}
+
+// initRPC initializes the block for an incoming stream.
+//
+// the rpc context derives directly from ctx with a single WithCancel.
+// the caller holds the initial block reference, see release.
+func (b *serverRPCBlock) initRPC(ctx context.Context, mux Mux, rwc io.ReadWriteCloser) *ServerRPC {
+	atomic.StoreInt32(&b.refs, 1)
+	b.queue.maxMsgs = defaultRecvWindowMsgs
+	b.queue.maxBytes = defaultRecvWindowBytes
+	b.prw.rw = rwc
+	rpc := &b.rpc
+	rpc.mux = mux
+	rpc.dataQueue = &b.queue
+	rpc.writer = &b.prw
+	rpc.pooled = b
+	rpc.ctx, rpc.ctxCancel = context.WithCancel(ctx)
+	return rpc
+}
+
+// acquire adds a reference to the block.
+func (b *serverRPCBlock) acquire() {
+	atomic.AddInt32(&b.refs, 1)
+}
+
+// release drops a reference, recycling the block at zero.
+func (b *serverRPCBlock) release() {
+	if atomic.AddInt32(&b.refs, -1) != 0 {
+		return
+	}
+	b.reset()
+	b.srv.rpcPool.Put(b)
+}
+
+// reset clears the block state for reuse, keeping the allocations.
+// called only after all references were released: no locking needed.
+func (b *serverRPCBlock) reset() {
+	// drop queued data references, keeping the list capacity.
+	list := b.queue.list[:cap(b.queue.list)]
+	for i := range list {
+		list[i] = recvMsg{}
+	}
+	b.queue.list = b.queue.list[:0]
+	b.queue.bytes = 0
+	b.queue.closed = false
+	// drain stale wakeup signals.
+	select {
+	case <-b.queue.readCh:
+	default:
+	}
+	select {
+	case <-b.queue.writeCh:
+	default:
+	}
+	b.rpc = ServerRPC{}
+	b.prw = PacketReaderWriter{}
+}
@@ -3,6 +3,7 @@ package srpc
 import (
 	"context"
 	"io"
+	"time"
 
 	"github.com/pkg/errors"
 )
@@ -22,24 +23,33 @@ type ServerRPC struct {
 	service string
 	// method is the rpc method
 	method string
-	// dataCh contains queued data packets.
-	// closed when the client closes the channel.
-	dataCh chan []byte
-	// dataChClosed is a flag set after dataCh is closed.
+	// dataQueue contains queued data packets.
+	// closed when the client completes the rpc.
+	dataQueue *recvQueue
+	// dataClosed is a flag set after dataQueue is closed.
 	// controlled by HandlePacket.
-	dataChClosed bool
+	dataClosed bool
 	// clientErr is an error set by the client.
-	// before dataCh is closed, managed by HandlePacket.
-	// immutable after dataCh is closed or ctxCancel
+	// before dataQueue is closed, managed by HandlePacket.
+	// immutable after dataQueue is closed or ctxCancel
 	clientErr error
+	// stats tracks rpc events, nil if no stats handler is registered.
+	stats *rpcStats
+	// compressCodec compresses message data, nil if disabled.
+	// set by HandleCallStart from the data_compress field.
+	compressCodec CompressionCodec
+	// strm is the message stream storage used by invokeRPC.
+	strm MsgStream
+	// pooled is the containing pooled block, nil if unpooled.
+	pooled *serverRPCBlock
 }
 
 // NewServerRPC constructs a new ServerRPC session.
 // note: call SetWriter before handling any incoming messages.
 func NewServerRPC(ctx context.Context, mux Mux) *ServerRPC {
 	rpc := &ServerRPC{
-		dataCh: make(chan []byte, 5),
-		mux:    mux,
+		dataQueue: newRecvQueue(),
+		mux:       mux,
 	}
 	rpc.ctx, rpc.ctxCancel = context.WithCancel(ctx)
 	return rpc
@@ -67,7 +77,7 @@ func (r *ServerRPC) Wait(ctx context.Context) error {
 
 // HandleStreamClose handles the incoming stream closing w/ optional error.
 func (r *ServerRPC) HandleStreamClose(closeErr error) {
-	if r.dataChClosed {
+	if r.dataClosed {
 		return
 	}
 	if closeErr != nil {
@@ -78,8 +88,8 @@ func (r *ServerRPC) HandleStreamClose(closeErr error) {
 			r.Close()
 		}
 	}
-	r.dataChClosed = true
-	close(r.dataCh)
+	r.dataClosed = true
+	r.dataQueue.close()
 }
 
 // HandlePacket handles an incoming parsed message packet.
@@ -97,6 +107,8 @@ func (r *ServerRPC) HandlePacket(msg *Packet) error {
 		return r.HandleCallStart(b.CallStart)
 	case *Packet_CallData:
 		return r.HandleCallData(b.CallData)
+	case *Packet_CallCancel:
+		return r.HandleCallCancel()
 	default:
 		return nil
 	}
@@ -108,41 +120,102 @@ func (r *ServerRPC) HandleCallStart(pkt *CallStart) error {
 	if r.method != "" || r.service != "" {
 		return errors.New("call start must be sent only once")
 	}
-	if r.dataChClosed {
+	if r.dataClosed {
 		return ErrCompleted
 	}
 	r.method, r.service = pkt.GetRpcMethod(), pkt.GetRpcService()
+	r.stats = newRPCStats(r.service, r.method, false)
+
+	// look up the compression codec offered by the client, if any.
+	var err error
+	if r.compressCodec, err = getCompressionCodec(pkt.GetDataCompress()); err != nil {
+		return err
+	}
+
+	// apply the client deadline to the invoke context, if any.
+	if deadlineMs := pkt.GetDeadlineUnixMs(); deadlineMs != 0 {
+		prevCancel := r.ctxCancel
+		var deadlineCancel context.CancelFunc
+		r.ctx, deadlineCancel = context.WithDeadline(r.ctx, time.UnixMilli(deadlineMs))
+		r.ctxCancel = func() {
+			deadlineCancel()
+			prevCancel()
+		}
+	}
 
 	// process first data packet, if included
 	if data := pkt.GetData(); len(data) != 0 || pkt.GetDataIsZero() {
 		if data == nil {
 			data = []byte{}
 		}
-		select {
-		case r.dataCh <- data:
-		default:
-			// the channel should be empty w/ a buffer capacity of 5 here.
-			return errors.New("data channel was full, expected empty")
+		// unary fast path: when the full request arrives with the call
+		// start & the handler supports it, invoke the method inline,
+		// skipping the goroutine and message stream machinery.
+		// note: this runs on the connection read loop, unary handlers
+		// should avoid blocking.
+		// note: the fast path skips the message stream which applies
+		// the compression codec, so it cannot run on compressed rpcs.
+		// call start data is never chunked, see SetDataChunkSize.
+		if ui, ok := r.mux.(UnaryInvoker); ok && r.compressCodec == nil {
+			if out, handled, err := ui.InvokeUnaryMethod(r.ctx, r.service, r.method, data); handled {
+				r.stats.recvMsg(len(data))
+				return r.completeUnary(out, err)
+			}
 		}
+		if !r.dataQueue.tryPush(data) {
+			// the queue should be empty here.
+			return errors.New("data queue was full, expected empty")
+		}
+		r.stats.recvMsg(len(data))
 	}
 
 	// invoke the rpc
+	if r.pooled != nil {
+		r.pooled.acquire()
+	}
 	go r.invokeRPC()
 
 	return nil
 }
 
+// completeUnary writes the unary response & completes the rpc.
+func (r *ServerRPC) completeUnary(out Message, rpcErr error) error {
+	var outPkt *Packet
+	if rpcErr == nil && out != nil {
+		outData, err := out.MarshalVT()
+		if err != nil {
+			rpcErr = err
+		} else {
+			outPkt = NewCallDataPacket(outData, len(outData) == 0, true, nil)
+			r.stats.sentMsg(len(outData))
+		}
+	}
+	if outPkt == nil {
+		outPkt = NewCallDataPacket(nil, false, true, rpcErr)
+	}
+	r.stats.complete(rpcErr)
+	_ = r.writer.WritePacketPooled(outPkt)
+	_ = r.writer.Close()
+	r.dataClosed = true
+	r.dataQueue.close()
+	r.ctxCancel()
+	return nil
+}
+
 // HandleCallData handles the call data packet.
 func (r *ServerRPC) HandleCallData(pkt *CallData) error {
-	if r.dataChClosed {
+	if r.dataClosed {
 		return ErrCompleted
 	}
 
 	if data := pkt.GetData(); len(data) != 0 || pkt.GetDataIsZero() {
-		select {
-		case <-r.ctx.Done():
-			return context.Canceled
-		case r.dataCh <- data:
+		if err := r.dataQueue.push(r.ctx, data, pkt.GetDataContinued()); err != nil {
+			return err
+		}
+		if pkt.GetDataContinued() {
+			r.stats.recvFragment(len(data))
+		} else {
+			r.stats.recvMsg(len(data))
 		}
 	}
 
@@ -153,26 +226,47 @@ func (r *ServerRPC) HandleCallData(pkt *CallData) error {
 	}
 
 	if complete {
-		r.dataChClosed = true
-		close(r.dataCh)
+		r.dataClosed = true
+		r.dataQueue.close()
 	}
 
 	return nil
 }
 
+// HandleCallCancel handles an incoming call cancel packet.
+// cancels the invoke context and tears down the rpc.
+func (r *ServerRPC) HandleCallCancel() error {
+	r.HandleStreamClose(context.Canceled)
+	r.ctxCancel()
+	return nil
+}
+
 // invoke invokes the RPC after CallStart is received.
 func (r *ServerRPC) invokeRPC() {
-	// ctx := r.ctx
 	serviceID, methodID := r.service, r.method
-	strm := NewMsgStream(r.ctx, r.writer, r.dataCh)
+	// the stream storage is embedded in the rpc: no extra allocation.
+	strm := &r.strm
+	strm.ctx = r.ctx
+	strm.writer = r.writer
+	strm.dataQueue = r.dataQueue
+	strm.setStats(r.stats)
+	strm.setCompression(r.compressCodec)
 	ok, err := r.mux.InvokeMethod(serviceID, methodID, strm)
 	if err == nil && !ok {
 		err = ErrUnimplemented
 	}
-	outPkt := NewCallDataPacket(nil, false, true, err)
-	_ = r.writer.WritePacket(outPkt)
+	r.stats.complete(err)
+	// skip the completion packet if the handler already sent it with the
+	// final message, see MsgSendAndClose. errors are always written.
+	if err != nil || !strm.sentClose {
+		outPkt := NewCallDataPacket(nil, false, true, err)
+		_ = r.writer.WritePacketPooled(outPkt)
+	}
 	_ = r.writer.Close()
 	r.ctxCancel()
+	if r.pooled != nil {
+		r.pooled.release()
+	}
 }
 
 // Close releases any resources held by the ServerRPC.
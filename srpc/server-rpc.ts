@@ -10,8 +10,8 @@ export class ServerRPC extends CommonRPC {
   // lookupMethod looks up the incoming RPC methods.
   private lookupMethod: LookupMethod
 
-  constructor(lookupMethod: LookupMethod) {
-    super()
+  constructor(lookupMethod: LookupMethod, highWaterMark?: number) {
+    super(highWaterMark)
     this.lookupMethod = lookupMethod
   }
 
@@ -25,11 +25,15 @@ export class ServerRPC extends CommonRPC {
     if (!this.service || !this.method) {
       throw new Error('rpcService and rpcMethod cannot be empty')
     }
+    if (packet.dataCompress) {
+      // compression is not yet implemented in the TypeScript server.
+      throw new Error(`unsupported compression type: ${packet.dataCompress}`)
+    }
     const methodDef = await this.lookupMethod(this.service, this.method)
     if (!methodDef) {
       throw new Error(`not found: ${this.service}/${this.method}`)
     }
-    this.pushRpcData(packet.data, packet.dataIsZero)
+    await this.pushRpcData(packet.data, packet.dataIsZero)
     this.invokeRPC(methodDef)
   }
 
@@ -3,6 +3,9 @@ package srpc
 import (
 	"context"
 	"io"
+	"sync"
+	"sync/atomic"
+	"time"
 
 	"github.com/libp2p/go-libp2p-core/network"
 )
@@ -11,6 +14,17 @@ import (
 type Server struct {
 	// mux is the srpc mux
 	mux Mux
+	// rpcSem bounds in-flight rpc streams, nil if unlimited.
+	rpcSem chan struct{}
+	// maxConnStreams bounds concurrent streams per muxed connection.
+	// 0 indicates no limit.
+	maxConnStreams int
+	// rpcPool recycles per-RPC state blocks, see serverRPCBlock.
+	rpcPool sync.Pool
+	// keepAliveInterval is the keep-alive probe interval, 0 if disabled.
+	keepAliveInterval time.Duration
+	// keepAliveTimeout is the silence duration before reaping a conn.
+	keepAliveTimeout time.Duration
 }
 
 // NewServer constructs a new SRPC server.
@@ -20,20 +34,66 @@ func NewServer(mux Mux) *Server {
 	}
 }
 
+// NewServerWithLimits constructs a SRPC server with admission limits.
+//
+// maxConnStreams bounds concurrent streams per muxed connection and
+// maxRPCs bounds in-flight rpc streams across the server, 0 disables
+// either limit. streams over a limit are rejected with a cheap
+// ErrServerOverloaded error packet before any rpc state is allocated.
+func NewServerWithLimits(mux Mux, maxConnStreams, maxRPCs int) *Server {
+	srv := NewServer(mux)
+	srv.maxConnStreams = maxConnStreams
+	if maxRPCs > 0 {
+		srv.rpcSem = make(chan struct{}, maxRPCs)
+	}
+	return srv
+}
+
 // GetMux returns the mux.
 func (s *Server) GetMux() Mux {
 	return s.mux
 }
 
+// SetKeepAlive enables keep-alive probes on packet streams handled by
+// the server, reaping connections whose remote goes silent.
+//
+// applies to streams handled with HandlePacketStream (and accept loops
+// built on it, see AcceptPacketListener). must be called before
+// handling connections. see PacketReaderWriter.SetKeepAlive.
+func (s *Server) SetKeepAlive(interval, timeout time.Duration) {
+	s.keepAliveInterval = interval
+	s.keepAliveTimeout = timeout
+}
+
 // HandleStream handles an incoming ReadWriteCloser stream.
 func (s *Server) HandleStream(ctx context.Context, rwc io.ReadWriteCloser) error {
-	subCtx, subCtxCancel := context.WithCancel(ctx)
-	defer subCtxCancel()
-	serverRPC := NewServerRPC(subCtx, s.mux)
+	// the per-RPC state comes from the server pool as a single block.
+	blk := s.getRPCBlock()
+	serverRPC := blk.initRPC(ctx, s.mux, rwc)
+	// capture the cancel: the block may recycle before the defer runs.
+	ctxCancel := serverRPC.ctxCancel
+	defer ctxCancel()
+	blk.acquire() // read pump reference
+	go func() {
+		blk.prw.ReadPump(serverRPC.HandlePacket, serverRPC.HandleStreamClose)
+		blk.release()
+	}()
+	err := serverRPC.Wait(ctx)
+	blk.release()
+	return err
+}
+
+// HandlePacketStream handles a packet stream carrying many RPCs
+// multiplexed by rpc id, without a per-RPC stream muxer.
+//
+// Blocks until the stream closes.
+func (s *Server) HandlePacketStream(ctx context.Context, rwc io.ReadWriteCloser) error {
 	prw := NewPacketReadWriter(rwc)
-	serverRPC.SetWriter(prw)
-	go prw.ReadPump(serverRPC.HandlePacket, serverRPC.HandleStreamClose)
-	return serverRPC.Wait(ctx)
+	if s.keepAliveInterval > 0 {
+		prw.SetKeepAlive(s.keepAliveInterval, s.keepAliveTimeout)
+	}
+	pm := NewPacketMuxWithStream(ctx, prw, false, s)
+	return pm.Wait(ctx)
 }
 
 // AcceptMuxedConn runs a loop which calls Accept on a muxer to handle streams.
@@ -41,6 +101,8 @@ func (s *Server) HandleStream(ctx context.Context, rwc io.ReadWriteCloser) error
 // Starts HandleStream in a separate goroutine to handle the stream.
 // Returns context.Canceled or io.EOF when the loop is complete / closed.
 func (s *Server) AcceptMuxedConn(ctx context.Context, mplex network.MuxedConn) error {
+	// connStreams counts in-flight streams on this connection.
+	var connStreams int64
 	for {
 		select {
 		case <-ctx.Done():
@@ -55,8 +117,56 @@ func (s *Server) AcceptMuxedConn(ctx context.Context, mplex network.MuxedConn) e
 		if err != nil {
 			return err
 		}
+
+		// admission: reject the stream cheaply when over a limit,
+		// before any rpc state is allocated.
+		if s.maxConnStreams > 0 && atomic.AddInt64(&connStreams, 1) > int64(s.maxConnStreams) {
+			atomic.AddInt64(&connStreams, -1)
+			go rejectStream(muxedStream)
+			continue
+		}
+		if !s.tryAcquireRPC() {
+			if s.maxConnStreams > 0 {
+				atomic.AddInt64(&connStreams, -1)
+			}
+			go rejectStream(muxedStream)
+			continue
+		}
+
 		go func() {
 			_ = s.HandleStream(ctx, muxedStream)
+			s.releaseRPC()
+			if s.maxConnStreams > 0 {
+				atomic.AddInt64(&connStreams, -1)
+			}
 		}()
 	}
 }
+
+// tryAcquireRPC reserves an in-flight rpc slot.
+// returns false if the server rpc limit was reached.
+func (s *Server) tryAcquireRPC() bool {
+	if s.rpcSem == nil {
+		return true
+	}
+	select {
+	case s.rpcSem <- struct{}{}:
+		return true
+	default:
+		return false
+	}
+}
+
+// releaseRPC returns an in-flight rpc slot.
+func (s *Server) releaseRPC() {
+	if s.rpcSem != nil {
+		<-s.rpcSem
+	}
+}
+
+// rejectStream writes an overload error packet and closes the stream.
+func rejectStream(rwc io.ReadWriteCloser) {
+	prw := NewPacketReadWriter(rwc)
+	_ = prw.WritePacketPooled(NewCallDataPacket(nil, false, true, ErrServerOverloaded))
+	_ = prw.Close()
+}
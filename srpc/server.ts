@@ -18,9 +18,12 @@ import { RpcStreamHandler } from '../rpcstream/rpcstream.js'
 export class Server implements StreamHandler {
   // lookupMethod looks up the incoming RPC methods.
   private lookupMethod: LookupMethod
+  // highWaterMark bounds the rpc queues, throttling producers.
+  private highWaterMark?: number
 
-  constructor(lookupMethod: LookupMethod) {
+  constructor(lookupMethod: LookupMethod, highWaterMark?: number) {
     this.lookupMethod = lookupMethod
+    this.highWaterMark = highWaterMark
   }
 
   // rpcStreamHandler implements the RpcStreamHandler interface.
@@ -31,7 +34,7 @@ export class Server implements StreamHandler {
   // startRpc starts a new server-side RPC.
   // the returned RPC handles incoming Packets.
   public startRpc(): ServerRPC {
-    return new ServerRPC(this.lookupMethod)
+    return new ServerRPC(this.lookupMethod, this.highWaterMark)
   }
 
   // handleStream handles an incoming Uint8Array message duplex.
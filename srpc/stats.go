@@ -0,0 +1,156 @@
+package srpc
+
+import (
+	"sync/atomic"
+	"time"
+)
+
+// StatsHandler observes RPC lifecycle events.
+//
+// registered globally with SetStatsHandler. the methods may be called
+// concurrently and run on the rpc hot path: implementations should be
+// quick and avoid blocking.
+type StatsHandler interface {
+	// HandleStreamOpen is called when an rpc stream opens.
+	// isClient indicates the local side initiated the rpc.
+	HandleStreamOpen(service, method string, isClient bool)
+	// HandleFirstByte is called when the first message data arrives,
+	// with the time elapsed since the stream opened.
+	HandleFirstByte(service, method string, isClient bool, elapsed time.Duration)
+	// HandleComplete is called once when the rpc completes.
+	// reports the total message and byte counts in both directions, the
+	// rpc duration, and the rpc error, if any.
+	HandleComplete(
+		service, method string,
+		isClient bool,
+		sentMsgs, sentBytes, recvMsgs, recvBytes uint64,
+		elapsed time.Duration,
+		rpcErr error,
+	)
+}
+
+// statsHandler is the registered stats handler, if any.
+// stores statsHandlerBox: guarded by atomic, SetStatsHandler may be
+// called concurrently with in-flight rpcs.
+var statsHandler atomic.Value
+
+// statsHandlerBox wraps the handler in a concrete type for atomic.Value,
+// which requires a consistent stored type across handler implementations.
+type statsHandlerBox struct {
+	h StatsHandler
+}
+
+// SetStatsHandler registers the handler observing rpc lifecycle events.
+// pass nil to unregister.
+//
+// with no handler registered (the default) the instrumentation cost is
+// a single nil check per event.
+func SetStatsHandler(h StatsHandler) {
+	statsHandler.Store(statsHandlerBox{h: h})
+}
+
+// getStatsHandler returns the registered stats handler, if any.
+func getStatsHandler() StatsHandler {
+	box, ok := statsHandler.Load().(statsHandlerBox)
+	if !ok {
+		return nil
+	}
+	return box.h
+}
+
+// rpcStats accumulates counters for a single rpc.
+//
+// a nil *rpcStats is valid and all methods are no-ops on it, so call
+// sites pay only a nil-receiver branch when no handler is registered.
+type rpcStats struct {
+	// handler receives the events.
+	handler StatsHandler
+	// service is the rpc service
+	service string
+	// method is the rpc method
+	method string
+	// isClient indicates the local side initiated the rpc.
+	isClient bool
+	// openTime is when the stream opened.
+	openTime time.Time
+
+	// firstByte is set once the first byte event fired.
+	firstByte uint32
+	// completed is set once the completion event fired.
+	completed uint32
+	// sentMsgs counts outgoing messages.
+	sentMsgs uint64
+	// sentBytes counts outgoing message bytes.
+	sentBytes uint64
+	// recvMsgs counts incoming messages.
+	recvMsgs uint64
+	// recvBytes counts incoming message bytes.
+	recvBytes uint64
+}
+
+// newRPCStats emits the stream-open event and starts stats for an rpc.
+// returns nil (a valid no-op receiver) if no handler is registered.
+func newRPCStats(service, method string, isClient bool) *rpcStats {
+	h := getStatsHandler()
+	if h == nil {
+		return nil
+	}
+	h.HandleStreamOpen(service, method, isClient)
+	return &rpcStats{
+		handler:  h,
+		service:  service,
+		method:   method,
+		isClient: isClient,
+		openTime: time.Now(),
+	}
+}
+
+// sentMsg records an outgoing message of n bytes.
+func (s *rpcStats) sentMsg(n int) {
+	if s == nil {
+		return
+	}
+	atomic.AddUint64(&s.sentMsgs, 1)
+	atomic.AddUint64(&s.sentBytes, uint64(n))
+}
+
+// recvMsg records an incoming message of n bytes.
+// emits the first-byte event on the first call.
+func (s *rpcStats) recvMsg(n int) {
+	if s == nil {
+		return
+	}
+	if atomic.CompareAndSwapUint32(&s.firstByte, 0, 1) {
+		s.handler.HandleFirstByte(s.service, s.method, s.isClient, time.Since(s.openTime))
+	}
+	atomic.AddUint64(&s.recvMsgs, 1)
+	atomic.AddUint64(&s.recvBytes, uint64(n))
+}
+
+// recvFragment records n incoming bytes of a chunked message fragment
+// without counting a message.
+func (s *rpcStats) recvFragment(n int) {
+	if s == nil {
+		return
+	}
+	if atomic.CompareAndSwapUint32(&s.firstByte, 0, 1) {
+		s.handler.HandleFirstByte(s.service, s.method, s.isClient, time.Since(s.openTime))
+	}
+	atomic.AddUint64(&s.recvBytes, uint64(n))
+}
+
+// complete emits the completion event, at most once.
+func (s *rpcStats) complete(rpcErr error) {
+	if s == nil {
+		return
+	}
+	if !atomic.CompareAndSwapUint32(&s.completed, 0, 1) {
+		return
+	}
+	s.handler.HandleComplete(
+		s.service, s.method, s.isClient,
+		atomic.LoadUint64(&s.sentMsgs), atomic.LoadUint64(&s.sentBytes),
+		atomic.LoadUint64(&s.recvMsgs), atomic.LoadUint64(&s.recvBytes),
+		time.Since(s.openTime), rpcErr,
+	)
+}
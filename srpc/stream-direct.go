@@ -0,0 +1,135 @@
+package srpc
+
+import (
+	"context"
+	"io"
+	"sync"
+
+	"google.golang.org/protobuf/proto"
+)
+
+// directStream implements an in-process stream which passes Message
+// objects directly between the two ends without serializing them.
+//
+// the message object is handed to the remote as-is: the sender must
+// not modify a message after passing it to MsgSend.
+type directStream struct {
+	ctx       context.Context
+	ctxCancel context.CancelFunc
+	// other is the other end of the stream.
+	other *directStream
+	// closeOnce ensures we close only once.
+	closeOnce sync.Once
+	// msgCh is the incoming message channel
+	msgCh chan Message
+	// sendClosed is closed when this end will send no more messages.
+	// the channel itself is never closed, avoiding send panics.
+	sendClosed chan struct{}
+	// remoteErr is an error set by the remote before closing sendClosed.
+	remoteErr error
+}
+
+// NewDirectStream constructs a new in-process stream pair which passes
+// Message objects directly between the ends, without serialization.
+func NewDirectStream(ctx context.Context) (Stream, Stream) {
+	s1, s2 := newDirectStreamPair(ctx)
+	return s1, s2
+}
+
+// newDirectStreamPair constructs the two ends of a direct stream.
+func newDirectStreamPair(ctx context.Context) (*directStream, *directStream) {
+	s1 := &directStream{msgCh: make(chan Message, 5), sendClosed: make(chan struct{})}
+	s1.ctx, s1.ctxCancel = context.WithCancel(ctx)
+	s2 := &directStream{other: s1, msgCh: make(chan Message, 5), sendClosed: make(chan struct{})}
+	s2.ctx, s2.ctxCancel = context.WithCancel(ctx)
+	s1.other = s2
+	return s1, s2
+}
+
+// Context is canceled when the Stream is no longer valid.
+func (p *directStream) Context() context.Context {
+	return p.ctx
+}
+
+// MsgSend sends the message to the remote.
+// the message must not be modified after the call.
+func (p *directStream) MsgSend(msg Message) error {
+	select {
+	case <-p.ctx.Done():
+		return context.Canceled
+	case <-p.sendClosed:
+		return io.ErrClosedPipe
+	case p.other.msgCh <- msg:
+		return nil
+	}
+}
+
+// MsgRecv receives an incoming message from the remote.
+// Copies the incoming message into the object at msg.
+func (p *directStream) MsgRecv(msg Message) error {
+	select {
+	case <-p.ctx.Done():
+		return context.Canceled
+	case in := <-p.msgCh:
+		return copyMessage(msg, in)
+	case <-p.other.sendClosed:
+		// drain any messages buffered before the close.
+		select {
+		case in := <-p.msgCh:
+			return copyMessage(msg, in)
+		default:
+		}
+		if err := p.remoteErr; err != nil {
+			return err
+		}
+		return io.EOF
+	}
+}
+
+// CloseSend signals to the remote that we will no longer send any messages.
+func (p *directStream) CloseSend() error {
+	p.closeRemote(nil)
+	return nil
+}
+
+// Close closes the stream.
+func (p *directStream) Close() error {
+	p.closeRemote(nil)
+	p.ctxCancel()
+	// unblock the remote end: a transport-backed stream cancels the
+	// server context when the client goes away.
+	p.other.ctxCancel()
+	return nil
+}
+
+// closeRemote marks the send side closed with an optional error.
+//
+// the message channel is never closed: the remote observes sendClosed
+// instead, so a concurrent or late MsgSend errors rather than panics.
+func (p *directStream) closeRemote(err error) {
+	p.closeOnce.Do(func() {
+		p.other.remoteErr = err
+		close(p.sendClosed)
+	})
+}
+
+// copyMessage copies the contents of in to out.
+//
+// uses protobuf reflection when both messages implement proto.Message,
+// avoiding serialization. falls back to a marshal round-trip otherwise.
+func copyMessage(out, in Message) error {
+	outPb, outOk := out.(proto.Message)
+	inPb, inOk := in.(proto.Message)
+	if outOk && inOk {
+		proto.Merge(outPb, inPb)
+		return nil
+	}
+	data, err := in.MarshalVT()
+	if err != nil {
+		return err
+	}
+	return out.UnmarshalVT(data)
+}
+
+// _ is a type assertion
+var _ Stream = ((*directStream)(nil))
@@ -0,0 +1,209 @@
+package srpc
+
+import (
+	"context"
+	"sync"
+	"time"
+)
+
+// poolOpenRetryDelay is the delay before retrying a failed pool refill.
+var poolOpenRetryDelay = time.Second
+
+// StreamPool keeps transport streams pre-opened ahead of demand.
+//
+// opening a stream pays the muxer stream exchange and read pump startup
+// on the caller's critical path. the pool hides that cost: OpenStream
+// pops a warm stream and only writes CallStart, while a background
+// goroutine refills the pool. streams that close while pooled are
+// discarded on pop and replaced by the refill pump.
+type StreamPool struct {
+	// ctx is the pool context: canceling it stops the refill pump.
+	ctx context.Context
+	// ctxCancel cancels ctx.
+	ctxCancel context.CancelFunc
+	// openStream opens a new transport stream.
+	openStream OpenStreamFunc
+	// ch contains the warm streams.
+	ch chan *warmStream
+}
+
+// NewStreamPool constructs a pool keeping size streams pre-opened.
+//
+// the pool refills asynchronously until ctx is canceled or Close is
+// called. OpenStream matches OpenStreamFunc and can be passed to
+// NewClient directly.
+func NewStreamPool(ctx context.Context, openStream OpenStreamFunc, size int) *StreamPool {
+	if size < 1 {
+		size = 1
+	}
+	p := &StreamPool{
+		openStream: openStream,
+		ch:         make(chan *warmStream, size),
+	}
+	p.ctx, p.ctxCancel = context.WithCancel(ctx)
+	go p.fillPump()
+	return p
+}
+
+// OpenStream pops a warm stream and attaches the handlers to it.
+//
+// falls back to opening a stream directly when the pool is empty.
+// implements OpenStreamFunc.
+func (p *StreamPool) OpenStream(ctx context.Context, msgHandler PacketHandler, closeHandler CloseHandler) (Writer, error) {
+	for {
+		select {
+		case ws := <-p.ch:
+			writer, ok := ws.attach(msgHandler, closeHandler)
+			if !ok {
+				// the stream closed while pooled: discard it.
+				continue
+			}
+			return writer, nil
+		default:
+			// pool empty: open on the caller path.
+			return p.openStream(ctx, msgHandler, closeHandler)
+		}
+	}
+}
+
+// Close stops the refill pump and closes the pooled streams.
+func (p *StreamPool) Close() {
+	p.ctxCancel()
+	for {
+		select {
+		case ws := <-p.ch:
+			ws.close()
+		default:
+			return
+		}
+	}
+}
+
+// fillPump keeps the pool filled with warm streams.
+func (p *StreamPool) fillPump() {
+	for {
+		ws := &warmStream{}
+		writer, err := p.openStream(p.ctx, ws.handlePacket, ws.handleClose)
+		if err != nil {
+			select {
+			case <-p.ctx.Done():
+				return
+			case <-time.After(poolOpenRetryDelay):
+				continue
+			}
+		}
+		ws.setWriter(writer)
+		select {
+		case p.ch <- ws:
+		case <-p.ctx.Done():
+			ws.close()
+			return
+		}
+	}
+}
+
+// warmStream is a pre-opened transport stream awaiting an RPC.
+//
+// buffers incoming packets and the close event until an RPC attaches
+// its handlers, then forwards to the attached handlers.
+type warmStream struct {
+	// mtx guards below fields
+	mtx sync.Mutex
+	// writer is the stream writer.
+	writer Writer
+	// handler handles incoming packets once attached.
+	handler PacketHandler
+	// closeHandler handles the stream closing once attached.
+	closeHandler CloseHandler
+	// queued contains packets received before attach.
+	queued []*Packet
+	// closed indicates the stream closed.
+	closed bool
+	// closeErr is the close error, if any.
+	closeErr error
+}
+
+// setWriter stores the stream writer.
+func (w *warmStream) setWriter(writer Writer) {
+	w.mtx.Lock()
+	w.writer = writer
+	w.mtx.Unlock()
+}
+
+// attach attaches the rpc handlers, replaying any buffered packets.
+// returns false if the stream closed while pooled.
+func (w *warmStream) attach(msgHandler PacketHandler, closeHandler CloseHandler) (Writer, bool) {
+	w.mtx.Lock()
+	defer w.mtx.Unlock()
+	if w.closed {
+		return nil, false
+	}
+	w.handler = msgHandler
+	w.closeHandler = closeHandler
+	for _, pkt := range w.queued {
+		if err := w.handler(pkt); err != nil {
+			// on a live stream a handler error tears the stream down:
+			// do the same here instead of dropping the error. detach
+			// the handlers first so the close is not delivered to the
+			// rpc, then discard the stream.
+			w.handler = nil
+			w.closeHandler = nil
+			w.queued = nil
+			w.closed = true
+			if w.writer != nil {
+				_ = w.writer.Close()
+			}
+			return nil, false
+		}
+	}
+	w.queued = nil
+	return w.writer, true
+}
+
+// handlePacket handles an incoming packet.
+// buffers the packet if no rpc is attached yet.
+func (w *warmStream) handlePacket(pkt *Packet) error {
+	w.mtx.Lock()
+	defer w.mtx.Unlock()
+	if w.handler != nil {
+		return w.handler(pkt)
+	}
+	// the read pump recycles pkt after this returns, see PacketHandler:
+	// deep-copy it before buffering for replay at attach.
+	data, err := pkt.MarshalVT()
+	if err != nil {
+		return err
+	}
+	queued := &Packet{}
+	if err := queued.UnmarshalVT(data); err != nil {
+		return err
+	}
+	w.queued = append(w.queued, queued)
+	return nil
+}
+
+// handleClose handles the stream closing.
+func (w *warmStream) handleClose(closeErr error) {
+	w.mtx.Lock()
+	w.closed = true
+	w.closeErr = closeErr
+	closeHandler := w.closeHandler
+	w.mtx.Unlock()
+	if closeHandler != nil {
+		closeHandler(closeErr)
+	}
+}
+
+// close closes the underlying stream.
+func (w *warmStream) close() {
+	w.mtx.Lock()
+	writer := w.writer
+	w.closed = true
+	w.mtx.Unlock()
+	if writer != nil {
+		_ = writer.Close()
+	}
+}
+
+// _ is a type assertion
+var _ OpenStreamFunc = (&StreamPool{}).OpenStream
@@ -0,0 +1,129 @@
+package srpc
+
+import (
+	"context"
+	"io"
+
+	"nhooyr.io/websocket"
+)
+
+// WebSocketSubprotocol is the subprotocol negotiated for direct packet
+// framing: each binary WebSocket message is exactly one Packet.
+const WebSocketSubprotocol = "srpc-packet"
+
+// webSocketPacketStream implements PacketStream over a WebSocket.
+//
+// WebSockets already provide message framing: each binary message
+// carries exactly one Packet, skipping the stream muxer and the length
+// prefix entirely. concurrency uses the rpc id mux, see PacketMux.
+type webSocketPacketStream struct {
+	// ctx is the connection context
+	ctx context.Context
+	// conn is the websocket conn
+	conn *websocket.Conn
+}
+
+// NewWebSocketPacketStream constructs a PacketStream over a WebSocket
+// where each binary message is exactly one Packet.
+//
+// usually used via NewWebSocketPacketMux.
+func NewWebSocketPacketStream(ctx context.Context, conn *websocket.Conn) PacketStream {
+	conn.SetReadLimit(int64(maxMessageSize))
+	return &webSocketPacketStream{ctx: ctx, conn: conn}
+}
+
+// NewWebSocketPacketMux constructs a PacketMux over a WebSocket where
+// each binary message is exactly one Packet.
+//
+// outbound indicates the local side initiated the connection.
+// srv is optional: if set, incoming calls are handled with the server.
+// the remote must negotiate the WebSocketSubprotocol subprotocol, see
+// HTTPServer and the TypeScript WebSocketPacketConn.
+func NewWebSocketPacketMux(ctx context.Context, conn *websocket.Conn, outbound bool, srv *Server) *PacketMux {
+	return NewPacketMuxWithStream(ctx, NewWebSocketPacketStream(ctx, conn), outbound, srv)
+}
+
+// WritePacket writes a packet as a single websocket message.
+func (w *webSocketPacketStream) WritePacket(p *Packet) error {
+	data, err := p.MarshalVT()
+	if err != nil {
+		return err
+	}
+	return w.conn.Write(w.ctx, websocket.MessageBinary, data)
+}
+
+// WritePacketPooled writes a packet using a pooled serialization buffer.
+func (w *webSocketPacketStream) WritePacketPooled(p *Packet) error {
+	bufPtr := writeBufPool.Get().(*[]byte)
+	buf := *bufPtr
+	msgSize := p.SizeVT()
+	if cap(buf) >= msgSize {
+		buf = buf[:msgSize]
+	} else {
+		buf = make([]byte, msgSize)
+	}
+	var err error
+	if _, err = p.MarshalToVT(buf); err == nil {
+		err = w.conn.Write(w.ctx, websocket.MessageBinary, buf)
+	}
+	*bufPtr = buf[:0]
+	writeBufPool.Put(bufPtr)
+	return err
+}
+
+// WritePackets writes a batch of packets.
+// each packet is one websocket message: the batch cannot be coalesced.
+func (w *webSocketPacketStream) WritePackets(pkts []*Packet) error {
+	for _, p := range pkts {
+		if err := w.WritePacketPooled(p); err != nil {
+			return err
+		}
+	}
+	return nil
+}
+
+// ReadPump reads packets to the handler until the connection closes.
+func (w *webSocketPacketStream) ReadPump(cb PacketHandler, closed CloseHandler) {
+	err := w.readToHandler(cb)
+	if closed != nil {
+		closed(err)
+	}
+}
+
+// readToHandler reads websocket messages to the given handler.
+func (w *webSocketPacketStream) readToHandler(cb PacketHandler) error {
+	for {
+		msgType, data, err := w.conn.Read(w.ctx)
+		if err != nil {
+			status := websocket.CloseStatus(err)
+			if status == websocket.StatusNormalClosure || status == websocket.StatusGoingAway ||
+				err == io.EOF || err == context.Canceled {
+				// closed
+				return nil
+			}
+			return err
+		}
+		if msgType != websocket.MessageBinary {
+			continue
+		}
+
+		// decode and emit the packet, returning it to the pool after.
+		npkt := GetPacket()
+		err = npkt.UnmarshalVT(data)
+		if err == nil {
+			err = cb(npkt)
+		}
+		ReleasePacket(npkt)
+		if err != nil {
+			return err
+		}
+	}
+}
+
+// Close closes the websocket.
+func (w *webSocketPacketStream) Close() error {
+	return w.conn.Close(websocket.StatusNormalClosure, "conn closed")
+}
+
+// _ is a type assertion
+var _ PacketStream = ((*webSocketPacketStream)(nil))
@@ -5,6 +5,7 @@ import { Direction } from '@libp2p/interface-connection'
 import type WebSocket from 'isomorphic-ws'
 
 import { Conn } from './conn.js'
+import { PacketConn, PacketConnParams } from './conn-packet.js'
 import { Server } from './server.js'
 
 // WebSocketConn implements a connection with a WebSocket and optional Server.
@@ -27,3 +28,31 @@ export class WebSocketConn extends Conn {
     return this.socket
   }
 }
+
+// WebSocketPacketConn implements a direct packet framing connection
+// with a WebSocket: each binary message is exactly one Packet, muxed by
+// rpc id, without the stream muxer layer.
+//
+// the socket must be opened with the 'srpc-packet' subprotocol, e.g.
+// new WebSocket(url, ['srpc-packet']), which the Go HTTPServer
+// negotiates at accept time.
+export class WebSocketPacketConn extends PacketConn {
+  // socket is the web socket
+  private socket: WebSocket
+
+  constructor(
+    socket: WebSocket,
+    server?: Server,
+    packetConnParams?: PacketConnParams
+  ) {
+    super(server, packetConnParams)
+    this.socket = socket
+    const socketDuplex = duplex(socket)
+    pipe(socketDuplex, this, socketDuplex)
+  }
+
+  // getSocket returns the websocket.
+  public getSocket(): WebSocket {
+    return this.socket
+  }
+}
@@ -4,6 +4,31 @@ package srpc
 type Writer interface {
 	// WritePacket writes a packet to the remote.
 	WritePacket(p *Packet) error
+	// WritePacketPooled writes a packet to the remote using a pooled
+	// serialization buffer, reusing memory across packets.
+	// the caller must not retain references to the marshaled data.
+	WritePacketPooled(p *Packet) error
+	// WritePackets writes a batch of packets to the remote coalesced
+	// into a single transport write.
+	WritePackets(pkts []*Packet) error
 	// Close closes the writer.
 	Close() error
 }
+
+// RawWriter is implemented by writers which can write pre-marshaled
+// packet data directly, see CallStartPrefix.
+type RawWriter interface {
+	// WriteRawPacket writes pre-marshaled packet data to the remote.
+	WriteRawPacket(data []byte) error
+}
+
+// PacketStream reads and writes framed packets over a transport.
+//
+// implemented by PacketReaderWriter with length-prefixed framing and by
+// transports with native message framing, see NewWebSocketPacketStream.
+type PacketStream interface {
+	Writer
+	// ReadPump reads packets to the handler until the stream closes,
+	// then calls the close handler with any error.
+	ReadPump(cb PacketHandler, closed CloseHandler)
+}
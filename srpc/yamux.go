@@ -0,0 +1,60 @@
+package srpc
+
+import (
+	"io"
+	"net"
+	"time"
+
+	"github.com/libp2p/go-libp2p-core/network"
+	yamux "github.com/libp2p/go-libp2p/p2p/muxer/yamux"
+)
+
+// yamuxWindowSize overrides the yamux per-stream receive window in bytes.
+// zero uses the yamux default.
+var yamuxWindowSize uint32
+
+// SetYamuxWindowSize overrides the yamux per-stream receive window.
+//
+// larger windows improve bulk-transfer throughput on high-latency links
+// at the cost of per-stream memory. zero restores the yamux default.
+// affects muxers constructed after the call.
+func SetYamuxWindowSize(size uint32) {
+	yamuxWindowSize = size
+}
+
+// NewYamuxMuxedConn constructs a yamux MuxedConn from a ReadWriteCloser.
+//
+// unlike mplex, yamux has per-stream flow control: a slow or stalled
+// stream backpressures only itself rather than the whole connection.
+func NewYamuxMuxedConn(conn io.ReadWriteCloser, outbound bool) (network.MuxedConn, error) {
+	tpt := *yamux.DefaultTransport
+	if yamuxWindowSize != 0 {
+		tpt.MaxStreamWindowSize = yamuxWindowSize
+	}
+	nc, ok := conn.(net.Conn)
+	if !ok {
+		nc = rwcConn{ReadWriteCloser: conn}
+	}
+	return tpt.NewConn(nc, !outbound, nil)
+}
+
+// rwcConn adapts a ReadWriteCloser to net.Conn for muxers that require
+// the full interface. deadlines are not supported and are ignored.
+type rwcConn struct {
+	io.ReadWriteCloser
+}
+
+func (rwcConn) LocalAddr() net.Addr                { return rwcAddr{} }
+func (rwcConn) RemoteAddr() net.Addr               { return rwcAddr{} }
+func (rwcConn) SetDeadline(t time.Time) error      { return nil }
+func (rwcConn) SetReadDeadline(t time.Time) error  { return nil }
+func (rwcConn) SetWriteDeadline(t time.Time) error { return nil }
+
+// rwcAddr is the placeholder addr for rwcConn.
+type rwcAddr struct{}
+
+func (rwcAddr) Network() string { return "rwc" }
+func (rwcAddr) String() string  { return "rwc" }
+
+// _ is a type assertion
+var _ net.Conn = rwcConn{}